@@ -0,0 +1,137 @@
+#include "OrderBook.h"
+#include "Order.h"
+#include "Types.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Reference check for the pro-rata and hybrid allocation policies
+//
+// Builds random single-level books, sweeps each with one aggressive order and
+// compares every resting order's fills with a brute-force allocation in plain
+// 64-bit integers: floor shares, then the remainder one lot at a time in time
+// priority. Sizes range up to 4e8 per order, so both the double and the
+// 64-bit integer passes of PriceLevel::allocateProRata are exercised.
+//
+// Usage: AllocationCheck [levels]
+
+namespace
+{
+    const Price PRICE = 10.0;
+    const int MAX_ORDERS_PER_LEVEL = 5;
+
+    // Expected fill per resting order, in time priority. Hybrid fills the top
+    // order first and splits the rest pro rata over the remaining orders.
+    std::vector<int64_t> referenceAllocation(const std::vector<int64_t> &resting, int64_t incoming, bool isHybrid)
+    {
+        std::vector<int64_t> expected(resting.size(), 0);
+        size_t first = 0;
+        int64_t left = incoming;
+
+        if (isHybrid)
+        {
+            expected[0] = std::min(resting[0], left);
+            left -= expected[0];
+            first = 1;
+        }
+
+        int64_t total = 0;
+        for (size_t i = first; i < resting.size(); ++i)
+        {
+            total += resting[i];
+        }
+        if (left == 0 || total == 0)
+        {
+            return expected;
+        }
+        if (left >= total)
+        {
+            for (size_t i = first; i < resting.size(); ++i)
+            {
+                expected[i] += resting[i];
+            }
+            return expected;
+        }
+
+        int64_t allocated = 0;
+        for (size_t i = first; i < resting.size(); ++i)
+        {
+            int64_t share = resting[i] * left / total;
+            expected[i] += share;
+            allocated += share;
+        }
+        for (size_t i = first; i < resting.size() && allocated < left; ++i)
+        {
+            expected[i]++;
+            allocated++;
+        }
+        return expected;
+    }
+
+    template <typename Book>
+    bool checkPolicy(const char *name, bool isHybrid, int levels, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+
+        for (int level = 0; level < levels; ++level)
+        {
+            Book orderBook("CHECK");
+
+            // Mix small lots, where the remainder matters, with sizes large
+            // enough to push total * incoming past 2^53
+            int orderCount = 1 + static_cast<int>(rng() % MAX_ORDERS_PER_LEVEL);
+            std::vector<int64_t> resting(orderCount);
+            int64_t total = 0;
+            for (int i = 0; i < orderCount; ++i)
+            {
+                resting[i] = 1 + rng() % (rng() % 2 ? 10 : 400000000);
+                total += resting[i];
+                orderBook.addOrder(std::make_shared<Order>("REST_" + std::to_string(i), Side::SELL, PRICE,
+                                                           static_cast<Quantity>(resting[i])));
+            }
+
+            // Up to a quarter more than the level holds, so some sweeps clear it
+            int64_t incoming = 1 + rng() % std::min<int64_t>(total + total / 4, 2000000000);
+            orderBook.addOrder(std::make_shared<Order>("AGGRESSOR", Side::BUY, PRICE, static_cast<Quantity>(incoming)));
+
+            std::map<OrderId, int64_t> filled;
+            for (const auto &trade : orderBook.getTrades())
+            {
+                filled[trade->sellOrderId] += trade->quantity;
+            }
+
+            std::vector<int64_t> expected = referenceAllocation(resting, std::min(incoming, total), isHybrid);
+            for (int i = 0; i < orderCount; ++i)
+            {
+                int64_t actual = filled["REST_" + std::to_string(i)];
+                if (actual != expected[i])
+                {
+                    std::cout << name << ": level " << level << ", order " << i << " filled " << actual
+                              << ", reference " << expected[i] << std::endl;
+                    return false;
+                }
+            }
+        }
+
+        std::cout << name << ": " << levels << " levels match the reference" << std::endl;
+        return true;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int levels = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+    std::cout << "=== ALLOCATION REFERENCE CHECK ===" << std::endl;
+    bool isHealthy = checkPolicy<ProRataOrderBook>("Pro-rata", false, levels, 5);
+    isHealthy = checkPolicy<HybridOrderBook>("Hybrid  ", true, levels, 3) && isHealthy;
+
+    std::cout << std::endl << (isHealthy ? "OK" : "FAILED") << std::endl;
+    return isHealthy ? 0 : 1;
+}
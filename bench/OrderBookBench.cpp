@@ -0,0 +1,317 @@
+#include "OrderBook.h"
+#include "Order.h"
+#include "Clock.h"
+#include "Types.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Memory and cache benchmark for resting orders
+//
+//   bytes per resting order: live heap growth while building a book that
+//   never crosses, divided by the number of orders
+//   deep sweep: one aggressive order takes out every level of a deep book;
+//   reports time per fill and, where the kernel exposes hardware counters,
+//   L1D and last-level cache misses
+//   end of day: time for one expiry check to expire every DAY order in a
+//   book of EOD_ORDERS resting orders, with all of them DAY and with 1%
+
+// --- Heap accounting ( every allocation in this process goes through here ) ---
+
+namespace
+{
+    std::atomic<long long> g_liveBytes{0};
+
+    struct AllocHeader
+    {
+        void *base;
+        size_t size;
+    };
+
+    void *countedAlloc(size_t size, size_t alignment)
+    {
+        alignment = std::max(alignment, alignof(std::max_align_t));
+        char *base = static_cast<char *>(std::malloc(size + alignment + sizeof(AllocHeader)));
+        if (!base)
+        {
+            throw std::bad_alloc();
+        }
+        uintptr_t user = (reinterpret_cast<uintptr_t>(base) + sizeof(AllocHeader) + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        AllocHeader *header = reinterpret_cast<AllocHeader *>(user) - 1;
+        header->base = base;
+        header->size = size;
+        g_liveBytes += static_cast<long long>(size);
+        return reinterpret_cast<void *>(user);
+    }
+
+    void countedFree(void *ptr)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+        AllocHeader *header = static_cast<AllocHeader *>(ptr) - 1;
+        g_liveBytes -= static_cast<long long>(header->size);
+        std::free(header->base);
+    }
+}
+
+void *operator new(size_t size) { return countedAlloc(size, 0); }
+void *operator new[](size_t size) { return countedAlloc(size, 0); }
+void *operator new(size_t size, std::align_val_t alignment) { return countedAlloc(size, static_cast<size_t>(alignment)); }
+void *operator new[](size_t size, std::align_val_t alignment) { return countedAlloc(size, static_cast<size_t>(alignment)); }
+void operator delete(void *ptr) noexcept { countedFree(ptr); }
+void operator delete[](void *ptr) noexcept { countedFree(ptr); }
+void operator delete(void *ptr, size_t) noexcept { countedFree(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { countedFree(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { countedFree(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { countedFree(ptr); }
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept { countedFree(ptr); }
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept { countedFree(ptr); }
+
+// --- Hardware cache counters ---
+
+class CacheCounters
+{
+private:
+    int m_l1Access = -1;
+    int m_l1Miss = -1;
+    int m_llcMiss = -1;
+
+#ifdef __linux__
+    static int open(uint64_t cache, uint64_t result)
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (result << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    static uint64_t read(int fd)
+    {
+        uint64_t value = 0;
+        if (fd < 0 || ::read(fd, &value, sizeof(value)) != sizeof(value))
+        {
+            return 0;
+        }
+        return value;
+    }
+#endif
+
+public:
+    uint64_t l1Accesses = 0;
+    uint64_t l1Misses = 0;
+    uint64_t llcMisses = 0;
+
+    CacheCounters()
+    {
+#ifdef __linux__
+        m_l1Access = open(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_ACCESS);
+        m_l1Miss = open(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_MISS);
+        m_llcMiss = open(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_RESULT_MISS);
+#endif
+    }
+
+    ~CacheCounters()
+    {
+#ifdef __linux__
+        for (int fd : {m_l1Access, m_l1Miss, m_llcMiss})
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    bool isAvailable() const { return m_l1Access >= 0 && m_l1Miss >= 0; }
+
+    void start()
+    {
+#ifdef __linux__
+        for (int fd : {m_l1Access, m_l1Miss, m_llcMiss})
+        {
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    void stop()
+    {
+#ifdef __linux__
+        for (int fd : {m_l1Access, m_l1Miss, m_llcMiss})
+        {
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+        l1Accesses += read(m_l1Access);
+        l1Misses += read(m_l1Miss);
+        llcMisses += read(m_llcMiss);
+#endif
+    }
+};
+
+// --- Benchmarks ---
+
+namespace
+{
+    constexpr int BOOK_ORDERS = 200000;
+    constexpr int SWEEP_LEVELS = 1000;
+    constexpr int SWEEP_ORDERS_PER_LEVEL = 200;
+    constexpr int SWEEP_ROUNDS = 5;
+    constexpr int EOD_ORDERS = 1000000;
+    constexpr int EOD_ROUNDS = 3;
+
+    void evictCaches()
+    {
+        static std::vector<char> scratch(64 * 1024 * 1024);
+        for (size_t i = 0; i < scratch.size(); i += 64)
+        {
+            scratch[i]++;
+        }
+    }
+}
+
+void benchmarkBytesPerOrder()
+{
+    long long before = g_liveBytes;
+    {
+        OrderBook orderBook("BENCH");
+
+        // Bids below asks, so nothing crosses and every order rests
+        for (int i = 0; i < BOOK_ORDERS; ++i)
+        {
+            bool isBuy = (i % 2) == 0;
+            Price price = isBuy ? 100.0 - (i % 500) * 0.01 : 101.0 + (i % 500) * 0.01;
+            orderBook.addOrder(std::make_shared<Order>("ORD_" + std::to_string(i), isBuy ? Side::BUY : Side::SELL, price, 100));
+        }
+
+        long long bytes = g_liveBytes - before;
+        std::cout << "Resting orders:          " << orderBook.getTotalOrders() << std::endl;
+        std::cout << "Bytes per resting order: " << std::fixed << std::setprecision(1)
+                  << static_cast<double>(bytes) / BOOK_ORDERS << std::endl;
+    }
+}
+
+void benchmarkDeepSweep()
+{
+    CacheCounters counters;
+    double totalNanos = 0;
+    size_t totalFills = 0;
+
+    for (int round = 0; round < SWEEP_ROUNDS; ++round)
+    {
+        OrderBook orderBook("BENCH");
+
+        // Interleave levels so each level's queue is spread through memory
+        for (int i = 0; i < SWEEP_LEVELS * SWEEP_ORDERS_PER_LEVEL; ++i)
+        {
+            Price price = 100.0 + (i % SWEEP_LEVELS) * 0.01;
+            orderBook.addOrder(std::make_shared<Order>("ASK_" + std::to_string(i), Side::SELL, price, 10));
+        }
+        auto sweeper = std::make_shared<Order>("SWEEP", Side::BUY, 100.0 + SWEEP_LEVELS * 0.01,
+                                               SWEEP_LEVELS * SWEEP_ORDERS_PER_LEVEL * 10);
+        evictCaches();
+
+        counters.start();
+        auto start = std::chrono::steady_clock::now();
+        orderBook.addOrder(sweeper);
+        auto end = std::chrono::steady_clock::now();
+        counters.stop();
+
+        totalNanos += std::chrono::duration<double, std::nano>(end - start).count();
+        totalFills += orderBook.getTotalTrades();
+    }
+
+    std::cout << "Deep sweep:              " << SWEEP_LEVELS << " levels x " << SWEEP_ORDERS_PER_LEVEL
+              << " orders, " << SWEEP_ROUNDS << " rounds" << std::endl;
+    std::cout << "Time per fill:           " << std::fixed << std::setprecision(1)
+              << totalNanos / totalFills << " ns" << std::endl;
+
+    if (!counters.isAvailable())
+    {
+        std::cout << "Cache misses:            n/a (hardware counters unavailable)" << std::endl;
+        return;
+    }
+    std::cout << "L1D miss rate:           " << std::setprecision(2)
+              << 100.0 * counters.l1Misses / std::max<uint64_t>(counters.l1Accesses, 1) << " %" << std::endl;
+    std::cout << "L1D misses per fill:     " << static_cast<double>(counters.l1Misses) / totalFills << std::endl;
+    std::cout << "LLC misses per fill:     " << static_cast<double>(counters.llcMisses) / totalFills << std::endl;
+}
+
+void benchmarkEndOfDay(int dayOrderPercent)
+{
+    double totalMillis = 0;
+    size_t totalExpired = 0;
+
+    for (int round = 0; round < EOD_ROUNDS; ++round)
+    {
+        Timestamp start = std::chrono::system_clock::now();
+        auto clock = std::make_shared<ManualClock>(start);
+        OrderBook orderBook("BENCH", clock);
+        orderBook.setEndOfDay(start + std::chrono::hours(8));
+
+        // Same non-crossing book as above; the DAY orders are spread evenly
+        for (int i = 0; i < EOD_ORDERS; ++i)
+        {
+            bool isBuy = (i % 2) == 0;
+            Price price = isBuy ? 100.0 - (i % 500) * 0.01 : 101.0 + (i % 500) * 0.01;
+            TimeInForce timeInForce = (i % 100) < dayOrderPercent ? TimeInForce::DAY : TimeInForce::GTC;
+            orderBook.addOrder(std::make_shared<Order>("ORD_" + std::to_string(i), isBuy ? Side::BUY : Side::SELL,
+                                                       price, 100, timeInForce));
+        }
+        clock->advance(std::chrono::hours(9));
+        evictCaches();
+
+        auto begin = std::chrono::steady_clock::now();
+        totalExpired += orderBook.expireOrders();
+        auto end = std::chrono::steady_clock::now();
+        totalMillis += std::chrono::duration<double, std::milli>(end - begin).count();
+    }
+
+    std::cout << "End of day:              " << totalExpired / EOD_ROUNDS << " DAY of " << EOD_ORDERS
+              << " orders, " << EOD_ROUNDS << " rounds" << std::endl;
+    std::cout << "Time to expire:          " << std::fixed << std::setprecision(1)
+              << totalMillis / EOD_ROUNDS << " ms (" << totalMillis * 1e6 / totalExpired << " ns per order)" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== ORDER BOOK MEMORY BENCHMARK ===" << std::endl;
+    benchmarkBytesPerOrder();
+    std::cout << std::endl;
+    benchmarkDeepSweep();
+    std::cout << std::endl;
+    benchmarkEndOfDay(100);
+    benchmarkEndOfDay(1);
+    return 0;
+}
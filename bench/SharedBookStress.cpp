@@ -0,0 +1,253 @@
+#include "OrderBook.h"
+#include "BookPublisher.h"
+#include "BookReader.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Multi-reader stress test for shared-memory book publication
+//
+// The parent runs a random add/cancel workload against one book, first
+// without a publisher ( baseline ) and then publishing every change while
+// N forked reader processes snapshot the book as fast as they can. Readers
+// check every snapshot for tearing ( crossed or unordered levels, update IDs
+// going backwards ) and report their counts through a pipe.
+//
+// Usage: SharedBookStress [readers] [seconds]
+
+namespace
+{
+    const char *SHM_NAME = "/orderbook_stress";
+    const char *SYMBOL = "STRESS";
+
+    struct ReaderStats
+    {
+        uint64_t snapshots;
+        uint64_t retries;
+        uint64_t violations;
+    };
+
+    struct EngineStats
+    {
+        uint64_t operations;
+        double meanNanos;
+        double p50Nanos;
+        double p99Nanos;
+    };
+
+    bool isConsistent(const BookSnapshot &snapshot, uint64_t lastUpdateId)
+    {
+        if (std::strncmp(snapshot.symbol, SYMBOL, SHARED_SYMBOL_LENGTH) != 0 || snapshot.updateId < lastUpdateId)
+        {
+            return false;
+        }
+        if (snapshot.bidDepth > SHARED_BOOK_DEPTH || snapshot.askDepth > SHARED_BOOK_DEPTH)
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i < snapshot.bidDepth; ++i)
+        {
+            if (snapshot.bids[i].quantity <= 0 || snapshot.bids[i].orderCount == 0 ||
+                (i > 0 && snapshot.bids[i].price >= snapshot.bids[i - 1].price))
+            {
+                return false;
+            }
+        }
+        for (uint32_t i = 0; i < snapshot.askDepth; ++i)
+        {
+            if (snapshot.asks[i].quantity <= 0 || snapshot.asks[i].orderCount == 0 ||
+                (i > 0 && snapshot.asks[i].price <= snapshot.asks[i - 1].price))
+            {
+                return false;
+            }
+        }
+        // A matched book never rests crossed
+        return snapshot.bidDepth == 0 || snapshot.askDepth == 0 ||
+               snapshot.getBestBidPrice() < snapshot.getBestAskPrice();
+    }
+
+    ReaderStats runReader(double seconds)
+    {
+        ReaderStats stats{0, 0, 0};
+        BookReader reader(SHM_NAME);
+
+        uint32_t slot;
+        if (!reader.findSymbol(SYMBOL, slot))
+        {
+            stats.violations = 1;
+            return stats;
+        }
+
+        BookSnapshot snapshot;
+        uint64_t lastUpdateId = 0;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            for (int i = 0; i < 64; ++i)
+            {
+                if (!reader.tryRead(slot, snapshot))
+                {
+                    stats.retries++;
+                    continue;
+                }
+                if (!isConsistent(snapshot, lastUpdateId))
+                {
+                    stats.violations++;
+                }
+                lastUpdateId = snapshot.updateId;
+                stats.snapshots++;
+            }
+        }
+        return stats;
+    }
+
+    EngineStats runEngine(OrderBook &orderBook, double seconds)
+    {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> tick(0, 60);
+        std::uniform_int_distribution<int> quantity(1, 20);
+        std::uniform_int_distribution<int> action(0, 9);
+
+        std::vector<OrderId> liveOrders;
+        std::vector<double> latencies;
+        uint64_t nextId = 0;
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            for (int i = 0; i < 256; ++i)
+            {
+                auto start = std::chrono::steady_clock::now();
+                if (action(rng) < 4 && !liveOrders.empty())
+                {
+                    size_t victim = rng() % liveOrders.size();
+                    orderBook.cancelOrder(liveOrders[victim]);
+                    liveOrders[victim] = liveOrders.back();
+                    liveOrders.pop_back();
+                }
+                else
+                {
+                    bool isBuy = rng() & 1;
+                    Price price = isBuy ? 99.50 + tick(rng) * 0.01 : 99.90 + tick(rng) * 0.01;
+                    OrderId id = "S" + std::to_string(nextId++);
+                    orderBook.addOrder(std::make_shared<Order>(id, isBuy ? Side::BUY : Side::SELL, price, quantity(rng)));
+                    liveOrders.push_back(id);
+                }
+                auto end = std::chrono::steady_clock::now();
+                latencies.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+            }
+        }
+
+        EngineStats stats;
+        stats.operations = latencies.size();
+        double total = 0;
+        for (double latency : latencies)
+        {
+            total += latency;
+        }
+        stats.meanNanos = total / latencies.size();
+        std::sort(latencies.begin(), latencies.end());
+        stats.p50Nanos = latencies[latencies.size() / 2];
+        stats.p99Nanos = latencies[latencies.size() * 99 / 100];
+        return stats;
+    }
+
+    void printEngineStats(const std::string &title, const EngineStats &stats, double seconds)
+    {
+        std::cout << title << std::endl;
+        std::cout << "  Operations:  " << stats.operations << " ("
+                  << std::fixed << std::setprecision(0) << stats.operations / seconds << " /s)" << std::endl;
+        std::cout << "  Latency:     mean " << std::setprecision(1) << stats.meanNanos
+                  << " ns, p50 " << stats.p50Nanos << " ns, p99 " << stats.p99Nanos << " ns" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int readerCount = argc > 1 ? std::atoi(argv[1]) : 4;
+    double seconds = argc > 2 ? std::atof(argv[2]) : 2.0;
+
+    std::cout << "=== SHARED BOOK STRESS TEST ===" << std::endl;
+    std::cout << "Readers: " << readerCount << ", duration: " << seconds << " s per phase" << std::endl;
+
+    {
+        OrderBook baseline(SYMBOL);
+        printEngineStats("\nEngine without publisher:", runEngine(baseline, seconds), seconds);
+    }
+
+    auto publisher = std::make_shared<BookPublisher>(SHM_NAME);
+    OrderBook orderBook(SYMBOL);
+    orderBook.setPublisher(publisher);
+
+    // Readers attach after the symbol is registered
+    std::vector<pid_t> children;
+    std::vector<int> pipes;
+    for (int i = 0; i < readerCount; ++i)
+    {
+        int fds[2];
+        if (pipe(fds) != 0)
+        {
+            std::cerr << "pipe failed" << std::endl;
+            return 1;
+        }
+
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            close(fds[0]);
+            ReaderStats stats = runReader(seconds);
+            ssize_t written = write(fds[1], &stats, sizeof(stats));
+            _exit(written == sizeof(stats) ? 0 : 1);
+        }
+        close(fds[1]);
+        children.push_back(pid);
+        pipes.push_back(fds[0]);
+    }
+
+    EngineStats published = runEngine(orderBook, seconds);
+
+    ReaderStats total{0, 0, 0};
+    bool isHealthy = true;
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        ReaderStats stats{0, 0, 0};
+        if (read(pipes[i], &stats, sizeof(stats)) != sizeof(stats))
+        {
+            isHealthy = false;
+        }
+        close(pipes[i]);
+
+        int status = 0;
+        waitpid(children[i], &status, 0);
+        isHealthy = isHealthy && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+
+        total.snapshots += stats.snapshots;
+        total.retries += stats.retries;
+        total.violations += stats.violations;
+    }
+
+    printEngineStats("\nEngine publishing to " + std::to_string(readerCount) + " readers:", published, seconds);
+    std::cout << "\nReaders:" << std::endl;
+    std::cout << "  Snapshots:   " << total.snapshots << " ("
+              << std::setprecision(0) << total.snapshots / seconds << " /s total)" << std::endl;
+    std::cout << "  Retries:     " << total.retries << std::endl;
+    std::cout << "  Torn reads:  " << total.violations << std::endl;
+
+    if (!isHealthy || total.violations > 0)
+    {
+        std::cout << "\nFAILED" << std::endl;
+        return 1;
+    }
+    std::cout << "\nOK" << std::endl;
+    return 0;
+}
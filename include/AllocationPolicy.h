@@ -0,0 +1,35 @@
+#pragma once
+#include "PriceLevel.h"
+#include <vector>
+
+// Allocation policies decide how an incoming order's quantity is split across
+// the orders resting at one price level. A book picks one as a template
+// parameter ( see BasicOrderBook ), so the choice is resolved at compile time
+// and a FIFO book calls straight into PriceLevel::match.
+
+// Strict time priority
+struct FifoAllocation
+{
+	static Quantity match(PriceLevel &level, Quantity quantity, std::vector<Fill> &fills)
+	{
+		return level.match(quantity, fills);
+	}
+};
+
+// In proportion to resting size; rounding remainder goes out in time priority
+struct ProRataAllocation
+{
+	static Quantity match(PriceLevel &level, Quantity quantity, std::vector<Fill> &fills)
+	{
+		return level.matchProRata(quantity, fills);
+	}
+};
+
+// Top order by time priority first, the rest of the level pro rata
+struct HybridAllocation
+{
+	static Quantity match(PriceLevel &level, Quantity quantity, std::vector<Fill> &fills)
+	{
+		return level.matchHybrid(quantity, fills);
+	}
+};
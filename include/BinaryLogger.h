@@ -0,0 +1,235 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Asynchronous binary logger for the engine path
+//
+// The calling thread never formats or does I/O. log() copies a format ID, a
+// timestamp and the raw argument bytes into a lock-free ring owned by the
+// calling thread, then returns. A background thread drains every ring,
+// expands the format and writes to the file in batches.
+//
+// Formats are registered once ( usually as statics ) and use {} for each
+// argument, or {%...} to pass a printf conversion, e.g. {%7.2f}. The
+// conversion must match the argument: integers, floating point or strings.
+// If a ring is full the record is dropped and counted, never waited on. A
+// thread's ring is freed once the thread has exited and the ring is drained.
+
+class BinaryLogger
+{
+public:
+	using FormatId = uint16_t;
+
+	static FormatId registerFormat(const char *pattern);
+
+	explicit BinaryLogger(const std::string &path, size_t ringCapacity = 1 << 20);
+	~BinaryLogger();
+
+	BinaryLogger(const BinaryLogger &) = delete;
+	BinaryLogger &operator=(const BinaryLogger &) = delete;
+
+	template <typename... Args>
+	bool log(FormatId format, const Args &...args);
+
+	// Blocks until every record logged before the call is written and flushed
+	void flush();
+
+	uint64_t getDroppedCount() const;
+
+	// Argument encoding ( public for the encoders below )
+	enum class ArgType : uint8_t
+	{
+		INT,
+		UINT,
+		DOUBLE,
+		STRING
+	};
+
+	static constexpr size_t MAX_STRING_ARG = 255;
+
+private:
+	// Single-producer / single-consumer byte ring, one per logging thread
+	struct Ring
+	{
+		std::unique_ptr<char[]> buffer;
+		uint64_t capacity;
+		alignas(64) std::atomic<uint64_t> writePosition{0};
+		uint64_t pendingWritePosition = 0; // Producer only: end of the reserved record
+		uint64_t cachedReadPosition = 0;   // Producer only: last view of readPosition
+		alignas(64) std::atomic<uint64_t> readPosition{0};
+		std::atomic<uint64_t> dropped{0};
+		std::atomic<bool> isRetired{false}; // Owning thread has exited: no more writes
+
+		explicit Ring(uint64_t bytes) : buffer(new char[bytes]), capacity(bytes) {}
+	};
+
+	struct RecordHeader
+	{
+		uint32_t length; // Whole record, padded to 8 bytes
+		FormatId format;
+		uint8_t argCount;
+		uint8_t reserved;
+		int64_t timestampNanos;
+	};
+
+	static constexpr FormatId PADDING_FORMAT = 0xFFFF;
+
+	// The calling thread's rings, one per logger ( defined in BinaryLogger.cpp )
+	struct ThreadRings;
+
+	uint64_t m_instanceId;
+	uint64_t m_ringCapacity;
+	std::FILE *m_file;
+
+	mutable std::mutex m_ringsMutex;
+	std::vector<std::shared_ptr<Ring>> m_rings; // Shared with the owning threads
+	uint64_t m_retiredDropped;                  // Drops counted by freed rings
+
+	std::mutex m_stateMutex;
+	std::condition_variable m_wakeConsumer;
+	std::condition_variable m_flushDone;
+	uint64_t m_flushRequests;
+	uint64_t m_flushesDone;
+	bool m_isStopping;
+	std::thread m_consumer;
+
+	Ring &threadRing();
+	char *reserve(Ring &ring, uint32_t length);
+	void commit(Ring &ring);
+
+	void runConsumer();
+	bool drain(Ring &ring, std::string &output);
+	void formatRecord(const char *record, std::string &output) const;
+};
+
+// --- Encoding of log() arguments ---
+
+namespace BinaryLogEncoding
+{
+	template <typename T, typename Enable = void>
+	struct Encoder;
+
+	template <typename T>
+	struct Encoder<T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type>
+	{
+		static size_t size(const T &) { return 1 + sizeof(int64_t); }
+		static char *write(char *out, const T &value)
+		{
+			int64_t wide = value;
+			*out++ = static_cast<char>(BinaryLogger::ArgType::INT);
+			std::memcpy(out, &wide, sizeof(wide));
+			return out + sizeof(wide);
+		}
+	};
+
+	template <typename T>
+	struct Encoder<T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type>
+	{
+		static size_t size(const T &) { return 1 + sizeof(uint64_t); }
+		static char *write(char *out, const T &value)
+		{
+			uint64_t wide = value;
+			*out++ = static_cast<char>(BinaryLogger::ArgType::UINT);
+			std::memcpy(out, &wide, sizeof(wide));
+			return out + sizeof(wide);
+		}
+	};
+
+	template <typename T>
+	struct Encoder<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+	{
+		static size_t size(const T &) { return 1 + sizeof(double); }
+		static char *write(char *out, const T &value)
+		{
+			double wide = value;
+			*out++ = static_cast<char>(BinaryLogger::ArgType::DOUBLE);
+			std::memcpy(out, &wide, sizeof(wide));
+			return out + sizeof(wide);
+		}
+	};
+
+	inline size_t stringSize(size_t length)
+	{
+		return 2 + (length < BinaryLogger::MAX_STRING_ARG ? length : BinaryLogger::MAX_STRING_ARG);
+	}
+
+	inline char *writeString(char *out, const char *data, size_t length)
+	{
+		uint8_t clipped = static_cast<uint8_t>(length < BinaryLogger::MAX_STRING_ARG ? length : BinaryLogger::MAX_STRING_ARG);
+		*out++ = static_cast<char>(BinaryLogger::ArgType::STRING);
+		*out++ = static_cast<char>(clipped);
+		std::memcpy(out, data, clipped);
+		return out + clipped;
+	}
+
+	template <>
+	struct Encoder<std::string>
+	{
+		static size_t size(const std::string &value) { return stringSize(value.size()); }
+		static char *write(char *out, const std::string &value) { return writeString(out, value.data(), value.size()); }
+	};
+
+	template <>
+	struct Encoder<const char *>
+	{
+		static size_t size(const char *value) { return stringSize(std::strlen(value)); }
+		static char *write(char *out, const char *value) { return writeString(out, value, std::strlen(value)); }
+	};
+
+	template <size_t N>
+	struct Encoder<char[N]>
+	{
+		static size_t size(const char (&value)[N]) { return stringSize(strnlen(value, N)); }
+		static char *write(char *out, const char (&value)[N]) { return writeString(out, value, strnlen(value, N)); }
+	};
+
+	template <typename T>
+	using EncoderFor = Encoder<typename std::remove_cv<T>::type>;
+}
+
+template <typename... Args>
+bool BinaryLogger::log(FormatId format, const Args &...args)
+{
+	static_assert(sizeof...(Args) < 256, "Too many log arguments");
+
+	size_t payload = 0;
+	size_t sizes[] = {0, BinaryLogEncoding::EncoderFor<Args>::size(args)...};
+	for (size_t size : sizes)
+	{
+		payload += size;
+	}
+	uint32_t length = static_cast<uint32_t>((sizeof(RecordHeader) + payload + 7) & ~size_t(7));
+
+	Ring &ring = threadRing();
+	char *record = reserve(ring, length);
+	if (!record)
+	{
+		return false;
+	}
+
+	RecordHeader header;
+	header.length = length;
+	header.format = format;
+	header.argCount = static_cast<uint8_t>(sizeof...(Args));
+	header.reserved = 0;
+	header.timestampNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count();
+	std::memcpy(record, &header, sizeof(header));
+
+	char *out = record + sizeof(header);
+	char *ends[] = {out, (out = BinaryLogEncoding::EncoderFor<Args>::write(out, args))...};
+	(void)ends;
+
+	commit(ring);
+	return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "SharedBook.h"
+#include <string>
+#include <vector>
+
+// Writer side of the shared-memory book region ( see SharedBook.h ).
+//
+// Creates a POSIX shared-memory object, lays out one seqlocked slot per
+// symbol and publishes snapshots into it. Single writer: publish from the
+// thread that owns the books. Construction fails if an object with the name
+// already exists. The object is unlinked when the publisher is destroyed;
+// readers that already mapped it keep their mapping.
+
+class BookPublisher
+{
+private:
+	std::string m_name;
+	SharedBookHeader *m_header;
+	size_t m_regionSize;
+	std::vector<std::string> m_symbols; // By slot
+
+public:
+	explicit BookPublisher(const std::string &name, uint32_t symbolCapacity = 64);
+	~BookPublisher();
+
+	BookPublisher(const BookPublisher &) = delete;
+	BookPublisher &operator=(const BookPublisher &) = delete;
+
+	// Returns the slot to publish the symbol's snapshots into
+	uint32_t registerSymbol(const std::string &symbol);
+
+	// Stamps symbol and next update ID, then writes the snapshot under the slot's seqlock
+	void publish(uint32_t slot, BookSnapshot &snapshot);
+
+	const std::string &getName() const { return m_name; }
+	uint32_t getSymbolCount() const { return m_header->symbolCount.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include "SharedBook.h"
+#include <string>
+
+// Reader side of the shared-memory book region ( see SharedBook.h ).
+//
+// Maps the region read-only; any number of processes can attach. Reads never
+// block the publisher and never take a lock. tryRead() makes one attempt,
+// read() retries until it gets a copy no publish overlapped.
+
+class BookReader
+{
+private:
+	std::string m_name;
+	const SharedBookHeader *m_header;
+	const SharedSymbolSlot *m_slots;
+	size_t m_regionSize;
+
+public:
+	explicit BookReader(const std::string &name);
+	~BookReader();
+
+	BookReader(const BookReader &) = delete;
+	BookReader &operator=(const BookReader &) = delete;
+
+	uint32_t getSymbolCount() const { return m_header->symbolCount.load(std::memory_order_acquire); }
+	bool findSymbol(const std::string &symbol, uint32_t &slot) const;
+
+	bool tryRead(uint32_t slot, BookSnapshot &snapshot) const;
+	void read(uint32_t slot, BookSnapshot &snapshot) const;
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include "Types.h"
+
+// Time source for the book. Injected so expiry can be driven by
+// replayed or simulated time instead of the wall clock.
+
+class Clock
+{
+public:
+	virtual ~Clock() = default;
+	virtual Timestamp now() const = 0;
+};
+
+class SystemClock : public Clock
+{
+public:
+	Timestamp now() const override { return std::chrono::system_clock::now(); }
+};
+
+// Clock that only moves when told to ( tests, replay, demos )
+class ManualClock : public Clock
+{
+private:
+	Timestamp m_now;
+
+public:
+	explicit ManualClock(Timestamp start = std::chrono::system_clock::now()) : m_now(start) {}
+
+	Timestamp now() const override { return m_now; }
+	void set(Timestamp time) { m_now = time; }
+	void advance(std::chrono::milliseconds delta) { m_now += delta; }
+};
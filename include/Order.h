@@ -2,35 +2,75 @@
 #include "Types.h"
 #include <memory>
 
+class BinaryLogger;
+class OrderStore;
+struct OrderRecord;
+
+// Order is the cold side of an order: identity, timestamps and time in force,
+// read for reporting. Price, side and open quantity are kept here only while
+// the order is not resting. While it rests they live in its compact
+// OrderRecord ( see OrderStore.h ) alone, and the getters read them from there.
+
 class Order
 {
+	friend class OrderStore;
+
 private:
+	struct Terms
+	{
+		Price price;
+		Quantity remainingQuantity;
+		Side side;
+	};
+
 	OrderId m_orderId;
-	Side m_side;
-	Price m_price;
-	Quantity m_quantity;
-	Quantity m_remainingQuantity;
 	Timestamp m_timestamp;
+	Timestamp m_expireTime;
+	union
+	{
+		Terms m_terms;             // Not resting
+		const OrderStore *m_store; // Resting: terms are in m_store->hot(m_handle)
+	};
+	Quantity m_quantity;
+	OrderHandle m_handle; // INVALID_HANDLE unless resting
+	TimeInForce m_timeInForce;
+
+	// Called by OrderStore when the order starts and stops resting
+	void attach(const OrderStore *store, OrderHandle handle);
+	void detach(const OrderRecord &record);
 
 public:
 	// Constructor
 	Order(const OrderId &orderId, Side side, Price price, Quantity quantity);
+	Order(const OrderId &orderId, Side side, Price price, Quantity quantity,
+		TimeInForce timeInForce, Timestamp expireTime = Timestamp());
+
+	// A copy would share the original's hot record
+	Order(const Order &) = delete;
+	Order &operator=(const Order &) = delete;
 
 	// Getters
 	const OrderId &getOrderId() const { return m_orderId; }
-	Side getSide() const { return m_side; }
-	Price getPrice() const { return m_price; }
+	Side getSide() const;
+	Price getPrice() const;
 	Quantity getQuantity() const { return m_quantity; }
-	Quantity getRemainingQuantity() const { return m_remainingQuantity; }
+	Quantity getRemainingQuantity() const;
 	const Timestamp &getTimestamp() const { return m_timestamp; }
+	TimeInForce getTimeInForce() const { return m_timeInForce; }
+	const Timestamp &getExpireTime() const { return m_expireTime; }
 
-	// Order operations
+	// Order operations ( a resting order is filled by its book )
 
 	void fill(Quantity quantity);
-	bool isFilled() const { return m_remainingQuantity == 0; }
+	bool isFilled() const { return getRemainingQuantity() == 0; }
+
+	// Hot record handle while resting in a book
+	bool isResting() const { return m_handle != INVALID_HANDLE; }
+	OrderHandle getHandle() const { return m_handle; }
 
 	// Display
 	std::string toString() const;
+	void logTo(BinaryLogger &logger) const; // toString() through the async logger
 };
 
-using OrderPtr = std::shared_ptr<Order>;
\ No newline at end of file
+using OrderPtr = std::shared_ptr<Order>;
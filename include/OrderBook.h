@@ -1,6 +1,12 @@
 #pragma once
 #include "PriceLevel.h"
 #include "Order.h"
+#include "OrderStore.h"
+#include "OrderIndex.h"
+#include "AllocationPolicy.h"
+#include "Clock.h"
+#include "TimerWheel.h"
+#include "BookPublisher.h"
 #include <map>
 #include <memory>
 #include <vector>
@@ -22,7 +28,29 @@ struct Trade
 
 using TradePtr = std::shared_ptr<Trade>;
 
-class OrderBook
+// ExecutionReport records an order leaving the book without trading
+
+enum class ExecType
+{
+	CANCELLED,
+	EXPIRED
+};
+
+struct ExecutionReport
+{
+	OrderId orderId;
+	ExecType type;
+	Side side;
+	Price price;
+	Quantity leavesQuantity; // Quantity that was still open when the order left
+	Timestamp timestamp;
+};
+
+// Order book for one symbol. AllocationPolicy ( see AllocationPolicy.h ) sets
+// how fills are shared among the orders resting at a price level.
+
+template <typename AllocationPolicy>
+class BasicOrderBook
 {
 private:
 	// Price level storage
@@ -30,22 +58,56 @@ private:
 	std::map<Price, std::shared_ptr<PriceLevel>> m_bidLevels; // Buy orders ( h to l )
 	std::map<Price, std::shared_ptr<PriceLevel>> m_askLevels; // Sell orders( l to h )
 
-	// Order tracking
-	std::unordered_map<OrderId, OrderPtr> m_orders;
+	// Order tracking. DAY orders all leave at end of day, so they are kept
+	// apart: owned in arrival order by m_dayOrders ( cancelled ones included )
+	// and found by ID through an index that is dropped whole.
+	std::unordered_map<OrderId, OrderPtr> m_orders; // GTC, GTT and GTD
+	std::vector<OrderPtr> m_dayOrders;
+	OrderIndex m_dayOrderIds;
+
+	// Hot records of every resting order, shared by this book's price levels.
+	// Held by pointer so the levels' references survive moving the book. It
+	// points back at orders owned above, so it is declared after them and
+	// destroyed while they are still alive.
+	std::unique_ptr<OrderStore> m_orderStore;
 
 	// Trade history
 	std::vector<TradePtr> m_trades;
 
+	// Orders leaving without a trade ( cancels, expiries )
+	std::vector<ExecutionReport> m_executionReports;
+
 	std::string m_symbol;
 
+	// Expiry
+	std::shared_ptr<Clock> m_clock;
+	TimerWheel m_expiryWheel; // GTT / GTD orders
+	Timestamp m_endOfDay;     // Shared by every DAY order
+	Timestamp m_operationTime; // Clock reading taken by the last expiry check
+
+	// Shared-memory publication ( optional )
+	std::shared_ptr<BookPublisher> m_publisher;
+	uint32_t m_publisherSlot;
+	bool m_depthChanged;         // Published levels changed since the last publish
+	Price m_publishedBidFloor;   // Worst published bid ( 0 while the side is shallower than the snapshot )
+	Price m_publishedAskCeiling; // Worst published ask ( max while the side is shallower than the snapshot )
+
 public:
-	explicit OrderBook(const std::string &symbol);
+	explicit BasicOrderBook(const std::string &symbol,
+		std::shared_ptr<Clock> clock = std::make_shared<SystemClock>());
 
 	// Order management
 	void addOrder(OrderPtr order);
 	bool cancelOrder(const OrderId &orderId);
 	OrderPtr getOrder(const OrderId &orderId) const;
 
+	// Expiry: DAY orders expire at end of day, GTT/GTD at their own expire time.
+	// Runs before every add/cancel; call it directly to expire on a timer.
+	void setEndOfDay(Timestamp endOfDay); // Expires against the old deadline first
+	const Timestamp &getEndOfDay() const { return m_endOfDay; }
+	size_t expireOrders();
+	size_t getPendingExpiries() const { return m_expiryWheel.size() + m_dayOrderIds.size(); }
+
 	// Market data queries
 	Price getBestBidPrice() const;
 	Price getBestAskPrice() const;
@@ -55,15 +117,22 @@ public:
 
 	// Order book state
 	bool isEmpty() const;
-	size_t getTotalOrders() const { return m_orders.size(); }
+	size_t getTotalOrders() const { return m_orders.size() + m_dayOrderIds.size(); }
 	size_t getTotalTrades() const { return m_trades.size(); }
 
 	// Trade history
 	const std::vector<TradePtr> &getTrades() const { return m_trades; }
 	TradePtr getLastTrade() const;
 
+	// Publish top of book and depth to out-of-process readers after every change
+	void setPublisher(std::shared_ptr<BookPublisher> publisher);
+
+	// Execution reports
+	const std::vector<ExecutionReport> &getExecutionReports() const { return m_executionReports; }
+
 	std::string toString() const;
 	void printOrderBook(int levels = 5) const;
+	void logOrderBook(BinaryLogger &logger, int levels = 5) const; // printOrderBook() without iostreams
 
 private:
 	// Core matching logic
@@ -74,9 +143,26 @@ private:
 	// helper methods
 
 	void addToAppropriateLevel(OrderPtr order);
+	void removeFromLevel(const Order &order);
 	void removePriceLevelIfEmpty(Side side, Price price);
-	void recordTrade(OrderPtr buyOrder, OrderPtr sellOrder, Price price, Quantity quantity);
+	void scheduleExpiry(const OrderPtr &order);
+	void cancelExpiry(const Order &order);
+	size_t expireDayOrders(Timestamp now);
+	void recordExecution(const Order &order, ExecType type, Timestamp timestamp);
+	void markDepthChanged(Side side, Price price);
+	void publishDepth();
+	void settleFills(const std::vector<Fill> &fills, const Order &incomingOrder, Price price);
+	void recordTrade(const Order &buyOrder, const Order &sellOrder, Price price, Quantity quantity);
 
 	// Validation
 	void validateOrder(OrderPtr order) const;
 };
+
+// Definitions live in OrderBook.cpp, instantiated for the policies below
+extern template class BasicOrderBook<FifoAllocation>;
+extern template class BasicOrderBook<ProRataAllocation>;
+extern template class BasicOrderBook<HybridAllocation>;
+
+using OrderBook = BasicOrderBook<FifoAllocation>;
+using ProRataOrderBook = BasicOrderBook<ProRataAllocation>;
+using HybridOrderBook = BasicOrderBook<HybridAllocation>;
@@ -0,0 +1,38 @@
+#pragma once
+#include "Order.h"
+#include <vector>
+
+// Hash index from order ID to order, for a set of orders that leaves all at
+// once. Open addressing over a flat array of plain pointers ( the owner keeps
+// the orders alive ), so clear() frees one array instead of a node per order.
+// Each slot caches its ID's hash: probing and growing only read the orders
+// themselves on a hash match.
+
+class OrderIndex
+{
+private:
+	struct Slot
+	{
+		Order *order; // nullptr: empty
+		size_t hash;
+	};
+
+	std::vector<Slot> m_slots; // Power of two, at most half full
+	size_t m_size;
+
+	static size_t hashOf(const OrderId &orderId);
+	size_t findSlot(const OrderId &orderId) const;
+	void place(Slot slot);
+	void grow();
+
+public:
+	OrderIndex();
+
+	Order *find(const OrderId &orderId) const;
+	void insert(Order *order); // Its ID must not be indexed yet
+	bool erase(const OrderId &orderId);
+	void clear();
+
+	size_t size() const { return m_size; }
+	bool isEmpty() const { return m_size == 0; }
+};
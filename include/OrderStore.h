@@ -0,0 +1,52 @@
+#pragma once
+#include "Order.h"
+#include <vector>
+
+// Hot record: everything the matching loop reads or writes for a resting
+// order. 32 bytes and 32-byte aligned, so two share one cache line.
+
+struct alignas(32) OrderRecord
+{
+	Price price;
+	Quantity remainingQuantity;
+	Side side;
+	OrderHandle prev; // FIFO links within the price level
+	OrderHandle next;
+};
+
+static_assert(sizeof(OrderRecord) == 32, "OrderRecord must stay at 32 bytes");
+
+// Pool of hot records for one book. A pointer to the cold Order for each record
+// is kept in a parallel array under the same handle and only read when
+// reporting. The book owns the orders and keeps each one alive while it rests.
+// allocate() moves an order's price, side and open quantity into its record
+// and release() hands them back, so the record is their only copy while the
+// order rests. Released handles go on a free list ( threaded through 'next' )
+// for reuse.
+
+class OrderStore
+{
+private:
+	std::vector<OrderRecord> m_hot;
+	std::vector<Order *> m_cold;
+	OrderHandle m_freeHead;
+	size_t m_size;
+
+public:
+	OrderStore();
+	~OrderStore();
+
+	OrderStore(const OrderStore &) = delete;
+	OrderStore &operator=(const OrderStore &) = delete;
+
+	OrderHandle allocate(Order *order);
+	void release(OrderHandle handle);
+	void reserve(size_t capacity);
+
+	OrderRecord &hot(OrderHandle handle) { return m_hot[handle]; }
+	const OrderRecord &hot(OrderHandle handle) const { return m_hot[handle]; }
+	Order *cold(OrderHandle handle) const { return m_cold[handle]; }
+
+	size_t size() const { return m_size; }
+	size_t capacity() const { return m_hot.size(); }
+};
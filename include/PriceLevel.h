@@ -1,37 +1,56 @@
 #pragma once
 #include "Order.h"
-#include <queue>
+#include "OrderStore.h"
 #include <vector>
 
 
 // The price for this level
-// FIFO queue of orders
+// FIFO queue of orders, linked through their hot records in the book's OrderStore
 // Sum of all order quantities
 
+// One fill taken from a resting order during matching. An order filled
+// completely is unlinked from its level but keeps its record, so the caller
+// can still report it; the caller then releases it from the OrderStore.
+struct Fill
+{
+	OrderHandle handle;
+	Quantity quantity;
+};
+
 class PriceLevel {
 private:
 	Price m_price;
-	std::queue<OrderPtr> m_orders;
+	OrderStore* m_store;
+	OrderHandle m_head;
+	OrderHandle m_tail;
+	size_t m_orderCount;
 	Quantity m_totalQuantity;
 public:
-	explicit PriceLevel(Price price);
+	PriceLevel(Price price, OrderStore& store);
 
 	void addOrder(OrderPtr order);
-	OrderPtr getNextOrder();
+	Order* getNextOrder(); // Owned by the book
 	void removeOrder();
+	void removeOrder(const Order& order);
 
 	// Query methods
 	Price getPrice() const { return m_price; }
 	Quantity getTotalQuantity() const { return m_totalQuantity; }
-	bool isEmpty() const { return m_orders.empty(); }
-	size_t getOrderCount() const { return m_orders.size(); }
+	bool isEmpty() const { return m_orderCount == 0; }
+	size_t getOrderCount() const { return m_orderCount; }
 
-	// Matching operations
-	Quantity match(Quantity quantity, std::vector<OrderPtr>& filledOrders);
+	// Matching operations ( one per allocation policy, see AllocationPolicy.h )
+	Quantity match(Quantity quantity, std::vector<Fill>& fills);
+	Quantity matchProRata(Quantity quantity, std::vector<Fill>& fills);
+	Quantity matchHybrid(Quantity quantity, std::vector<Fill>& fills);
 
 	std::string toString() const;
+	void logTo(BinaryLogger& logger) const;
 
 private:
+	Quantity fillFromHead(Quantity quantity, std::vector<Fill>& fills, size_t maxOrders);
+	Quantity allocateProRata(Quantity quantity, std::vector<Fill>& fills);
+	void unlink(OrderHandle handle);
 	void updateTotalQuantity();
 
-};
\ No newline at end of file
+};
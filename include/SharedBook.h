@@ -0,0 +1,75 @@
+#pragma once
+#include "Types.h"
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+// Layout of the shared-memory region the engine publishes books into.
+// Shared by BookPublisher ( writer, in the engine ) and BookReader ( any
+// number of reader processes ).
+//
+//   SharedBookHeader
+//   SharedSymbolSlot[symbolCapacity]   one per symbol, 64-byte aligned
+//
+// Each slot is a seqlock: the publisher bumps 'sequence' to odd, rewrites the
+// snapshot words and bumps it back to even. A reader copies the words between
+// two reads of 'sequence' and keeps the copy only if both reads match and are
+// even. The publisher never waits on readers. A reader retries only when its
+// copy overlapped a publish.
+
+constexpr uint64_t SHARED_BOOK_MAGIC = 0x4B4F4F4244524853ULL; // "SHRDBOOK"
+constexpr uint32_t SHARED_BOOK_VERSION = 1;
+constexpr uint32_t SHARED_BOOK_DEPTH = 10;
+constexpr size_t SHARED_SYMBOL_LENGTH = 16;
+
+struct DepthLevel
+{
+	Price price;
+	Quantity quantity;
+	uint32_t orderCount;
+};
+
+// One consistent view of a symbol's book
+struct BookSnapshot
+{
+	char symbol[SHARED_SYMBOL_LENGTH]; // NUL-padded
+	uint64_t updateId;                  // Publishes so far for this symbol
+	int64_t timestampNanos;             // Book clock at publish, ns since epoch
+	uint32_t bidDepth;
+	uint32_t askDepth;
+	DepthLevel bids[SHARED_BOOK_DEPTH]; // Best first
+	DepthLevel asks[SHARED_BOOK_DEPTH]; // Best first
+
+	Price getBestBidPrice() const { return bidDepth ? bids[0].price : 0.0; }
+	Price getBestAskPrice() const { return askDepth ? asks[0].price : 0.0; }
+};
+
+static_assert(std::is_trivially_copyable<BookSnapshot>::value, "BookSnapshot is copied word by word");
+static_assert(sizeof(BookSnapshot) % sizeof(uint64_t) == 0, "BookSnapshot must be a whole number of words");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Seqlock words must be lock-free to live in shared memory");
+
+constexpr size_t SNAPSHOT_WORDS = sizeof(BookSnapshot) / sizeof(uint64_t);
+
+struct alignas(64) SharedSymbolSlot
+{
+	std::atomic<uint64_t> sequence;           // Odd while the publisher is writing
+	std::atomic<uint64_t> words[SNAPSHOT_WORDS]; // BookSnapshot, stored as relaxed atomics
+};
+
+struct alignas(64) SharedBookHeader
+{
+	uint64_t magic;
+	uint32_t version;
+	uint32_t symbolCapacity;
+	std::atomic<uint32_t> symbolCount; // Slots below this are registered
+};
+
+inline size_t sharedBookRegionSize(uint32_t symbolCapacity)
+{
+	return sizeof(SharedBookHeader) + sizeof(SharedSymbolSlot) * symbolCapacity;
+}
+
+inline SharedSymbolSlot *sharedBookSlots(SharedBookHeader *header)
+{
+	return reinterpret_cast<SharedSymbolSlot *>(header + 1);
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "Types.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Hierarchical timing wheel for order expiry
+//
+// Six levels of 64 slots with a 1 ms tick. Level 0 holds timers due within
+// the next 64 ticks, level 1 within 64^2 ticks and so on ( about two years
+// in total ). When a lower level wraps, the matching slot one level up is
+// cascaded down. A bitmap per level lets advance() jump straight to the next
+// occupied slot, so idle time costs one step per 64 ticks at most.
+//
+// Timers are keyed by the order's OrderStore handle. Each slot is a list
+// linked through a table indexed by handle, as a price level links its
+// orders, so the owner cancels an order's timer in O(1) when the order stops
+// resting, before its handle can be reused.
+
+class TimerWheel
+{
+public:
+	static constexpr int LEVELS = 6;
+	static constexpr int SLOT_BITS = 6;
+	static constexpr int SLOTS = 1 << SLOT_BITS;
+
+	explicit TimerWheel(Timestamp start);
+
+	// Due on the first tick starting at or after expireTime: never early, at
+	// most one tick late. Replaces any timer the handle already has.
+	void schedule(OrderHandle handle, Timestamp expireTime);
+	void cancel(OrderHandle handle); // No-op if the handle has no timer
+
+	// Collect the handle of every timer due at or before 'now'
+	void advance(Timestamp now, std::vector<OrderHandle>& expired);
+
+	size_t size() const { return m_size; }
+	bool isEmpty() const { return m_size == 0; }
+
+private:
+	// Lists are the slots ( level * SLOTS + slot ), then timers scheduled for a
+	// tick already processed
+	static constexpr uint16_t OVERDUE_LIST = LEVELS * SLOTS;
+	static constexpr uint16_t NO_LIST = OVERDUE_LIST + 1;
+
+	struct Timer
+	{
+		uint64_t expireTick;
+		OrderHandle prev; // Links within its list
+		OrderHandle next;
+		uint16_t list;    // NO_LIST unless scheduled
+	};
+
+	struct List
+	{
+		OrderHandle head;
+		OrderHandle tail;
+	};
+
+	std::vector<Timer> m_timers;                  // Indexed by handle
+	std::array<List, OVERDUE_LIST + 1> m_lists;
+	std::array<uint64_t, LEVELS> m_occupied;      // One bit per non-empty slot
+	uint64_t m_currentTick;                       // Next tick to be processed
+	size_t m_size;
+
+	static uint64_t toTick(Timestamp time);
+
+	void link(OrderHandle handle, uint16_t list);
+	void unlink(OrderHandle handle);
+	OrderHandle takeList(uint16_t list); // Empties the list, returns its old head
+	void insert(OrderHandle handle);
+	void cascade(int level);
+	void expireSlot(std::vector<OrderHandle>& expired);
+};
@@ -1,17 +1,39 @@
 #pragma once
 #include <string>
 #include <chrono>
+#include <cstdint>
 
 using OrderId = std::string;
 using Price = double;
 using Quantity = int;
 using Timestamp = std::chrono::system_clock::time_point;
 
+// Index of an order's record inside its book's OrderStore
+using OrderHandle = uint32_t;
+constexpr OrderHandle INVALID_HANDLE = UINT32_MAX;
+
 enum class Side {
 	BUY,
 	SELL
 };
 
+// How long an order rests before the book expires it
+enum class TimeInForce {
+	GTC, // Good till cancelled
+	DAY, // Expires at the book's end of day
+	GTT, // Good till a given time
+	GTD  // Good till a given date ( caller passes that date's close )
+};
+
 inline std::string sideToString(Side side) {
 	return (side == Side::BUY) ? "BUY" : "SELL";
+}
+
+inline std::string timeInForceToString(TimeInForce timeInForce) {
+	switch (timeInForce) {
+	case TimeInForce::DAY: return "DAY";
+	case TimeInForce::GTT: return "GTT";
+	case TimeInForce::GTD: return "GTD";
+	default: return "GTC";
+	}
 }
\ No newline at end of file
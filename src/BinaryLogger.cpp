@@ -0,0 +1,422 @@
+#include "BinaryLogger.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <deque>
+#include <stdexcept>
+
+namespace
+{
+    const size_t MIN_RING_CAPACITY = 4096;
+    const size_t WRITE_BATCH_BYTES = 64 * 1024;
+    const auto IDLE_WAIT = std::chrono::milliseconds(1);
+
+    // Registered patterns, indexed by FormatId. A deque keeps references stable
+    // while new formats are registered.
+    std::mutex g_formatsMutex;
+    std::deque<std::string> g_formats;
+
+    std::atomic<uint64_t> g_nextInstanceId{1};
+
+    const std::string *findFormat(BinaryLogger::FormatId format)
+    {
+        std::lock_guard<std::mutex> lock(g_formatsMutex);
+        return format < g_formats.size() ? &g_formats[format] : nullptr;
+    }
+
+    void appendTimestamp(int64_t timestampNanos, std::string &output)
+    {
+        // The consumer formats records in time order per ring, so caching the
+        // broken-down second saves a gmtime call on almost every record
+        static thread_local int64_t cachedSecond = -1;
+        static thread_local char cachedPrefix[32];
+
+        int64_t second = timestampNanos / 1000000000;
+        if (second != cachedSecond)
+        {
+            std::time_t time = static_cast<std::time_t>(second);
+            std::tm parts;
+#ifdef _WIN32
+            gmtime_s(&parts, &time);
+#else
+            gmtime_r(&time, &parts);
+#endif
+            std::strftime(cachedPrefix, sizeof(cachedPrefix), "%Y-%m-%d %H:%M:%S", &parts);
+            cachedSecond = second;
+        }
+
+        char fraction[16];
+        std::snprintf(fraction, sizeof(fraction), ".%09lld ", static_cast<long long>(timestampNanos % 1000000000));
+        output += cachedPrefix;
+        output += fraction;
+    }
+
+    // printf specs from the pattern apply to 64-bit values, so integer
+    // conversions get an "ll" length modifier
+    std::string widenIntegerSpec(const std::string &spec)
+    {
+        std::string wide = spec.substr(0, spec.size() - 1);
+        wide += "ll";
+        wide += spec.back();
+        return wide;
+    }
+}
+
+// Keyed by logger instance ( IDs are never reused ). Retires every ring when
+// its thread exits; shared ownership keeps the ring valid even if its logger
+// is destroyed first.
+struct BinaryLogger::ThreadRings
+{
+    struct Entry
+    {
+        uint64_t instanceId;
+        std::shared_ptr<Ring> ring;
+    };
+    std::vector<Entry> entries;
+
+    ~ThreadRings()
+    {
+        for (auto &entry : entries)
+        {
+            entry.ring->isRetired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+BinaryLogger::FormatId BinaryLogger::registerFormat(const char *pattern)
+{
+    std::lock_guard<std::mutex> lock(g_formatsMutex);
+    if (g_formats.size() >= PADDING_FORMAT)
+    {
+        throw std::runtime_error("Too many log formats registered");
+    }
+    g_formats.emplace_back(pattern);
+    return static_cast<FormatId>(g_formats.size() - 1);
+}
+
+BinaryLogger::BinaryLogger(const std::string &path, size_t ringCapacity)
+    : m_instanceId(g_nextInstanceId.fetch_add(1)),
+      m_ringCapacity(MIN_RING_CAPACITY),
+      m_file(std::fopen(path.c_str(), "w")),
+      m_retiredDropped(0),
+      m_flushRequests(0),
+      m_flushesDone(0),
+      m_isStopping(false)
+{
+    if (!m_file)
+    {
+        throw std::runtime_error("Cannot open log file: " + path);
+    }
+
+    // Power of two so ring offsets are a mask
+    while (m_ringCapacity < ringCapacity)
+    {
+        m_ringCapacity <<= 1;
+    }
+
+    m_consumer = std::thread(&BinaryLogger::runConsumer, this);
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        m_isStopping = true;
+    }
+    m_wakeConsumer.notify_one();
+    m_consumer.join();
+    std::fclose(m_file);
+
+    // Threads still running keep only the shells of their rings
+    for (auto &ring : m_rings)
+    {
+        ring->buffer.reset();
+    }
+}
+
+void BinaryLogger::flush()
+{
+    std::unique_lock<std::mutex> lock(m_stateMutex);
+    uint64_t ticket = ++m_flushRequests;
+    m_wakeConsumer.notify_one();
+    m_flushDone.wait(lock, [this, ticket] { return m_flushesDone >= ticket; });
+}
+
+uint64_t BinaryLogger::getDroppedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+    uint64_t dropped = m_retiredDropped;
+    for (const auto &ring : m_rings)
+    {
+        dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+BinaryLogger::Ring &BinaryLogger::threadRing()
+{
+    static thread_local ThreadRings t_rings;
+    auto &entries = t_rings.entries;
+
+    // Fast path: this thread's last logger
+    if (!entries.empty() && entries.back().instanceId == m_instanceId)
+    {
+        return *entries.back().ring;
+    }
+    for (auto &entry : entries)
+    {
+        if (entry.instanceId == m_instanceId)
+        {
+            std::swap(entry, entries.back());
+            return *entries.back().ring;
+        }
+    }
+
+    // First record from this thread: the ring lives until the thread exits
+    // and the consumer has drained it
+    auto ring = std::make_shared<Ring>(m_ringCapacity);
+    {
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        m_rings.push_back(ring);
+    }
+    entries.push_back({m_instanceId, ring});
+    return *ring;
+}
+
+char *BinaryLogger::reserve(Ring &ring, uint32_t length)
+{
+    uint64_t write = ring.writePosition.load(std::memory_order_relaxed);
+    uint64_t offset = write & (ring.capacity - 1);
+    uint64_t tail = ring.capacity - offset;
+
+    // A record never wraps: if it does not fit before the end, pad to the end
+    uint64_t needed = tail < length ? tail + length : length;
+
+    if (write + needed - ring.cachedReadPosition > ring.capacity)
+    {
+        ring.cachedReadPosition = ring.readPosition.load(std::memory_order_acquire);
+        if (write + needed - ring.cachedReadPosition > ring.capacity)
+        {
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+
+    if (tail < length)
+    {
+        RecordHeader padding{};
+        padding.length = static_cast<uint32_t>(tail);
+        padding.format = PADDING_FORMAT;
+        std::memcpy(ring.buffer.get() + offset, &padding, sizeof(padding.length) + sizeof(padding.format));
+        offset = 0;
+    }
+
+    ring.pendingWritePosition = write + needed;
+    return ring.buffer.get() + offset;
+}
+
+void BinaryLogger::commit(Ring &ring)
+{
+    ring.writePosition.store(ring.pendingWritePosition, std::memory_order_release);
+}
+
+void BinaryLogger::runConsumer()
+{
+    std::string output;
+    output.reserve(WRITE_BATCH_BYTES * 2);
+    std::vector<Ring *> rings;
+    std::vector<Ring *> retired;
+    bool isDirty = false;
+
+    while (true)
+    {
+        uint64_t flushRequested;
+        bool isStopping;
+        {
+            std::lock_guard<std::mutex> lock(m_stateMutex);
+            flushRequested = m_flushRequests;
+            isStopping = m_isStopping;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            rings.clear();
+            for (const auto &ring : m_rings)
+            {
+                rings.push_back(ring.get());
+            }
+        }
+
+        // A ring retired before this drain has no writes left, so the drain
+        // empties it and it can be freed
+        bool didWork = false;
+        retired.clear();
+        for (Ring *ring : rings)
+        {
+            bool isRetired = ring->isRetired.load(std::memory_order_acquire);
+            didWork |= drain(*ring, output);
+            if (isRetired)
+            {
+                retired.push_back(ring);
+            }
+        }
+        if (!retired.empty())
+        {
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            for (Ring *ring : retired)
+            {
+                m_retiredDropped += ring->dropped.load(std::memory_order_relaxed);
+            }
+            auto isFreed = [&retired](const std::shared_ptr<Ring> &ring)
+            {
+                return std::find(retired.begin(), retired.end(), ring.get()) != retired.end();
+            };
+            m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), isFreed), m_rings.end());
+        }
+
+        bool isFlushPending = flushRequested > m_flushesDone;
+        if (output.size() >= WRITE_BATCH_BYTES || (!output.empty() && (!didWork || isFlushPending)))
+        {
+            std::fwrite(output.data(), 1, output.size(), m_file);
+            output.clear();
+            isDirty = true;
+        }
+        if (isDirty && (!didWork || isFlushPending))
+        {
+            std::fflush(m_file);
+            isDirty = false;
+        }
+        if (isFlushPending)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_stateMutex);
+                m_flushesDone = flushRequested;
+            }
+            m_flushDone.notify_all();
+        }
+
+        if (didWork)
+        {
+            continue;
+        }
+        if (isStopping)
+        {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(m_stateMutex);
+        m_wakeConsumer.wait_for(lock, IDLE_WAIT, [this] { return m_isStopping || m_flushRequests > m_flushesDone; });
+    }
+}
+
+bool BinaryLogger::drain(Ring &ring, std::string &output)
+{
+    uint64_t read = ring.readPosition.load(std::memory_order_relaxed);
+    uint64_t write = ring.writePosition.load(std::memory_order_acquire);
+    if (read == write)
+    {
+        return false;
+    }
+
+    while (read != write)
+    {
+        const char *record = ring.buffer.get() + (read & (ring.capacity - 1));
+        uint32_t length;
+        FormatId format;
+        std::memcpy(&length, record, sizeof(length));
+        std::memcpy(&format, record + sizeof(length), sizeof(format));
+
+        if (format != PADDING_FORMAT)
+        {
+            formatRecord(record, output);
+        }
+        read += length;
+    }
+
+    ring.readPosition.store(read, std::memory_order_release);
+    return true;
+}
+
+void BinaryLogger::formatRecord(const char *record, std::string &output) const
+{
+    RecordHeader header;
+    std::memcpy(&header, record, sizeof(header));
+    appendTimestamp(header.timestampNanos, output);
+
+    const std::string *pattern = findFormat(header.format);
+    if (!pattern)
+    {
+        output += "<unknown log format " + std::to_string(header.format) + ">\n";
+        return;
+    }
+
+    const char *args = record + sizeof(header);
+    uint8_t argsLeft = header.argCount;
+    char buffer[MAX_STRING_ARG + 64];
+
+    size_t position = 0;
+    while (position < pattern->size())
+    {
+        size_t open = pattern->find('{', position);
+        size_t close = open == std::string::npos ? std::string::npos : pattern->find('}', open);
+        if (close == std::string::npos)
+        {
+            output.append(*pattern, position, std::string::npos);
+            break;
+        }
+        output.append(*pattern, position, open - position);
+        position = close + 1;
+
+        if (argsLeft == 0)
+        {
+            output += "{?}";
+            continue;
+        }
+        argsLeft--;
+
+        std::string spec = pattern->substr(open + 1, close - open - 1);
+        ArgType type = static_cast<ArgType>(*args++);
+        switch (type)
+        {
+        case ArgType::INT:
+        {
+            int64_t value;
+            std::memcpy(&value, args, sizeof(value));
+            args += sizeof(value);
+            std::snprintf(buffer, sizeof(buffer), spec.empty() ? "%lld" : widenIntegerSpec(spec).c_str(),
+                          static_cast<long long>(value));
+            break;
+        }
+        case ArgType::UINT:
+        {
+            uint64_t value;
+            std::memcpy(&value, args, sizeof(value));
+            args += sizeof(value);
+            std::snprintf(buffer, sizeof(buffer), spec.empty() ? "%llu" : widenIntegerSpec(spec).c_str(),
+                          static_cast<unsigned long long>(value));
+            break;
+        }
+        case ArgType::DOUBLE:
+        {
+            double value;
+            std::memcpy(&value, args, sizeof(value));
+            args += sizeof(value);
+            std::snprintf(buffer, sizeof(buffer), spec.empty() ? "%g" : spec.c_str(), value);
+            break;
+        }
+        case ArgType::STRING:
+        {
+            uint8_t length = static_cast<uint8_t>(*args++);
+            std::string value(args, length);
+            args += length;
+            std::snprintf(buffer, sizeof(buffer), spec.empty() ? "%s" : spec.c_str(), value.c_str());
+            break;
+        }
+        default:
+            output += "<bad log argument>\n";
+            return;
+        }
+        output += buffer;
+    }
+    output += '\n';
+}
@@ -0,0 +1,150 @@
+#include "BookPublisher.h"
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ORDERBOOK_HAS_POSIX_SHM 1
+#endif
+
+namespace
+{
+    std::string toShmName(const std::string &name)
+    {
+        if (name.empty())
+        {
+            throw std::invalid_argument("Shared memory name cannot be empty");
+        }
+        return name[0] == '/' ? name : "/" + name;
+    }
+}
+
+BookPublisher::BookPublisher(const std::string &name, uint32_t symbolCapacity)
+    : m_name(toShmName(name)), m_header(nullptr), m_regionSize(sharedBookRegionSize(symbolCapacity))
+{
+    if (symbolCapacity == 0)
+    {
+        throw std::invalid_argument("Symbol capacity must be positive");
+    }
+
+#ifdef ORDERBOOK_HAS_POSIX_SHM
+    // Exclusive create: an existing object may be mapped by a live publisher
+    // and its readers, so it is never reused, resized or unlinked from here
+    int fd = shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 && errno == EEXIST)
+    {
+        throw std::runtime_error("Shared memory " + m_name + " already exists: another publisher is using it, "
+                                 "or a previous one exited without removing it (shm_unlink it to reuse the name)");
+    }
+    if (fd < 0)
+    {
+        throw std::runtime_error("shm_open failed for " + m_name + ": " + std::strerror(errno));
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(m_regionSize)) != 0)
+    {
+        int error = errno;
+        close(fd);
+        shm_unlink(m_name.c_str());
+        throw std::runtime_error("ftruncate failed for " + m_name + ": " + std::strerror(error));
+    }
+
+    void *region = mmap(nullptr, m_regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED)
+    {
+        shm_unlink(m_name.c_str());
+        throw std::runtime_error("mmap failed for " + m_name + ": " + std::strerror(errno));
+    }
+
+    // Fresh pages are zeroed; construct the atomics in place over them
+    m_header = new (region) SharedBookHeader();
+    m_header->version = SHARED_BOOK_VERSION;
+    m_header->symbolCapacity = symbolCapacity;
+    m_header->symbolCount.store(0, std::memory_order_relaxed);
+
+    SharedSymbolSlot *slots = sharedBookSlots(m_header);
+    for (uint32_t i = 0; i < symbolCapacity; ++i)
+    {
+        new (&slots[i]) SharedSymbolSlot();
+    }
+
+    // Readers check the magic last, so it goes in once everything else is visible
+    std::atomic_thread_fence(std::memory_order_release);
+    m_header->magic = SHARED_BOOK_MAGIC;
+#else
+    throw std::runtime_error("Shared-memory book publication needs POSIX shared memory");
+#endif
+}
+
+BookPublisher::~BookPublisher()
+{
+#ifdef ORDERBOOK_HAS_POSIX_SHM
+    if (m_header)
+    {
+        munmap(m_header, m_regionSize);
+        shm_unlink(m_name.c_str());
+    }
+#endif
+}
+
+uint32_t BookPublisher::registerSymbol(const std::string &symbol)
+{
+    if (symbol.empty() || symbol.size() >= SHARED_SYMBOL_LENGTH)
+    {
+        throw std::invalid_argument("Symbol must be 1 to " + std::to_string(SHARED_SYMBOL_LENGTH - 1) + " characters");
+    }
+
+    for (const auto &registered : m_symbols)
+    {
+        if (registered == symbol)
+        {
+            throw std::invalid_argument("Symbol " + symbol + " is already published");
+        }
+    }
+
+    uint32_t count = m_header->symbolCount.load(std::memory_order_relaxed);
+    if (count >= m_header->symbolCapacity)
+    {
+        throw std::length_error("Shared book region is full");
+    }
+    m_symbols.push_back(symbol);
+
+    // Empty book under the new symbol, visible before the count admits it
+    BookSnapshot snapshot{};
+    publish(count, snapshot);
+
+    m_header->symbolCount.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+void BookPublisher::publish(uint32_t slot, BookSnapshot &snapshot)
+{
+    SharedSymbolSlot &target = sharedBookSlots(m_header)[slot];
+
+    // Only this thread writes the slot, so the sequence can be read relaxed
+    uint64_t sequence = target.sequence.load(std::memory_order_relaxed);
+    snapshot.updateId = sequence / 2 + 1;
+
+    const std::string &symbol = m_symbols[slot];
+    std::memset(snapshot.symbol, 0, SHARED_SYMBOL_LENGTH);
+    std::memcpy(snapshot.symbol, symbol.data(), symbol.size());
+
+    uint64_t words[SNAPSHOT_WORDS];
+    std::memcpy(words, &snapshot, sizeof(snapshot));
+
+    target.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < SNAPSHOT_WORDS; ++i)
+    {
+        target.words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    target.sequence.store(sequence + 2, std::memory_order_release);
+}
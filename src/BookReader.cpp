@@ -0,0 +1,129 @@
+#include "BookReader.h"
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ORDERBOOK_HAS_POSIX_SHM 1
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ORDERBOOK_CPU_RELAX() _mm_pause()
+#else
+#define ORDERBOOK_CPU_RELAX() ((void)0)
+#endif
+
+BookReader::BookReader(const std::string &name)
+    : m_name(!name.empty() && name[0] != '/' ? "/" + name : name), m_header(nullptr), m_slots(nullptr), m_regionSize(0)
+{
+    if (name.empty())
+    {
+        throw std::invalid_argument("Shared memory name cannot be empty");
+    }
+
+#ifdef ORDERBOOK_HAS_POSIX_SHM
+    int fd = shm_open(m_name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        throw std::runtime_error("shm_open failed for " + m_name + ": " + std::strerror(errno));
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SharedBookHeader))
+    {
+        close(fd);
+        throw std::runtime_error("Shared book region " + m_name + " is not initialised");
+    }
+    m_regionSize = static_cast<size_t>(info.st_size);
+
+    void *region = mmap(nullptr, m_regionSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED)
+    {
+        throw std::runtime_error("mmap failed for " + m_name + ": " + std::strerror(errno));
+    }
+    m_header = static_cast<const SharedBookHeader *>(region);
+
+    bool isValid = m_header->magic == SHARED_BOOK_MAGIC;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    isValid = isValid && m_header->version == SHARED_BOOK_VERSION && m_regionSize >= sharedBookRegionSize(m_header->symbolCapacity);
+    if (!isValid)
+    {
+        munmap(region, m_regionSize);
+        m_header = nullptr;
+        throw std::runtime_error("Shared book region " + m_name + " has an unknown layout");
+    }
+    m_slots = reinterpret_cast<const SharedSymbolSlot *>(m_header + 1);
+#else
+    throw std::runtime_error("Shared-memory book publication needs POSIX shared memory");
+#endif
+}
+
+BookReader::~BookReader()
+{
+#ifdef ORDERBOOK_HAS_POSIX_SHM
+    if (m_header)
+    {
+        munmap(const_cast<SharedBookHeader *>(m_header), m_regionSize);
+    }
+#endif
+}
+
+bool BookReader::findSymbol(const std::string &symbol, uint32_t &slot) const
+{
+    uint32_t count = getSymbolCount();
+    BookSnapshot snapshot;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        read(i, snapshot);
+        if (std::strncmp(snapshot.symbol, symbol.c_str(), SHARED_SYMBOL_LENGTH) == 0)
+        {
+            slot = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BookReader::tryRead(uint32_t slot, BookSnapshot &snapshot) const
+{
+    if (slot >= getSymbolCount())
+    {
+        throw std::out_of_range("Symbol slot " + std::to_string(slot) + " is not registered");
+    }
+    const SharedSymbolSlot &source = m_slots[slot];
+
+    uint64_t before = source.sequence.load(std::memory_order_acquire);
+    if (before & 1)
+    {
+        return false; // Publish in progress
+    }
+
+    uint64_t words[SNAPSHOT_WORDS];
+    for (size_t i = 0; i < SNAPSHOT_WORDS; ++i)
+    {
+        words[i] = source.words[i].load(std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (source.sequence.load(std::memory_order_relaxed) != before)
+    {
+        return false; // A publish overlapped the copy
+    }
+
+    std::memcpy(&snapshot, words, sizeof(snapshot));
+    return true;
+}
+
+void BookReader::read(uint32_t slot, BookSnapshot &snapshot) const
+{
+    while (!tryRead(slot, snapshot))
+    {
+        ORDERBOOK_CPU_RELAX();
+    }
+}
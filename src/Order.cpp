@@ -1,14 +1,23 @@
 #include "Order.h"
+#include "BinaryLogger.h"
+#include "OrderStore.h"
 #include <sstream>
 #include <stdexcept>
 
 Order::Order(const OrderId& orderId, Side side, Price price, Quantity quantity)
+	: Order(orderId, side, price, quantity, TimeInForce::GTC)
+{
+}
+
+Order::Order(const OrderId& orderId, Side side, Price price, Quantity quantity,
+	TimeInForce timeInForce, Timestamp expireTime)
 	: m_orderId(orderId)
-	, m_side(side)
-	, m_price(price)
-	, m_quantity(quantity)
-	, m_remainingQuantity(quantity)
 	, m_timestamp(std::chrono::system_clock::now())
+	, m_expireTime(expireTime)
+	, m_terms{price, quantity, side}
+	, m_quantity(quantity)
+	, m_handle(INVALID_HANDLE)
+	, m_timeInForce(timeInForce)
 {
 	// Validation
 	if (price <= 0) {
@@ -20,21 +29,58 @@ Order::Order(const OrderId& orderId, Side side, Price price, Quantity quantity)
 	if (orderId.empty()) {
 		throw std::invalid_argument("Order ID cannot be empty");
 	}
+	bool needsExpireTime = timeInForce == TimeInForce::GTT || timeInForce == TimeInForce::GTD;
+	if (needsExpireTime && expireTime == Timestamp()) {
+		throw std::invalid_argument("GTT/GTD orders need an expire time");
+	}
+}
+
+Side Order::getSide() const {
+	return isResting() ? m_store->hot(m_handle).side : m_terms.side;
+}
+
+Price Order::getPrice() const {
+	return isResting() ? m_store->hot(m_handle).price : m_terms.price;
+}
+
+Quantity Order::getRemainingQuantity() const {
+	return isResting() ? m_store->hot(m_handle).remainingQuantity : m_terms.remainingQuantity;
 }
 
 void Order::fill(Quantity quantity) {
-	if (quantity > m_remainingQuantity) {
+	if (isResting()) {
+		throw std::logic_error("Resting orders are filled by their book");
+	}
+	if (quantity > m_terms.remainingQuantity) {
 		throw std::invalid_argument("Cannot fill more than remaining quantity");
 	}
-	m_remainingQuantity -= quantity;
+	m_terms.remainingQuantity -= quantity;
+}
+
+void Order::attach(const OrderStore* store, OrderHandle handle) {
+	m_store = store;
+	m_handle = handle;
+}
+
+void Order::detach(const OrderRecord& record) {
+	m_terms = Terms{record.price, record.remainingQuantity, record.side};
+	m_handle = INVALID_HANDLE;
 }
 
 std::string Order::toString() const {
 	std::ostringstream oss;
 	oss << "Order[ID=" << m_orderId
-		<< ", Side=" << sideToString(m_side)
-		<< ", Price=" << m_price
+		<< ", Side=" << sideToString(getSide())
+		<< ", Price=" << getPrice()
 		<< ", Qty=" << m_quantity
-		<< ", Remaining=" << m_remainingQuantity << "]";
+		<< ", Remaining=" << getRemainingQuantity()
+		<< ", TIF=" << timeInForceToString(m_timeInForce) << "]";
 	return oss.str();
-}
\ No newline at end of file
+}
+
+void Order::logTo(BinaryLogger& logger) const {
+	static const BinaryLogger::FormatId format = BinaryLogger::registerFormat(
+		"Order[ID={}, Side={}, Price={}, Qty={}, Remaining={}, TIF={}]");
+	logger.log(format, m_orderId, getSide() == Side::BUY ? "BUY" : "SELL", getPrice(),
+		m_quantity, getRemainingQuantity(), timeInForceToString(m_timeInForce));
+}
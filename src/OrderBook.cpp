@@ -1,29 +1,67 @@
 #include "OrderBook.h"
+#include "BinaryLogger.h"
 #include <stdexcept>
 #include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
-OrderBook::OrderBook(const std::string &symbol) : m_symbol(symbol)
+namespace
+{
+    // Start loading a cache line that a later pass reads, without waiting for it
+    void prefetch(const void *address)
+    {
+#ifdef _MSC_VER
+        _mm_prefetch(static_cast<const char *>(address), _MM_HINT_T0);
+#else
+        __builtin_prefetch(address);
+#endif
+    }
+}
+
+template <typename AllocationPolicy>
+BasicOrderBook<AllocationPolicy>::BasicOrderBook(const std::string &symbol, std::shared_ptr<Clock> clock)
+    : m_orderStore(std::make_unique<OrderStore>()), m_symbol(symbol), m_clock(clock), m_expiryWheel(clock ? clock->now() : Timestamp()),
+      m_operationTime(clock ? clock->now() : Timestamp()), m_publisherSlot(0), m_depthChanged(false),
+      m_publishedBidFloor(0.0), m_publishedAskCeiling(std::numeric_limits<Price>::max())
 {
     if (symbol.empty())
     {
         throw std::invalid_argument("Symbol cannot be empty");
     }
+    if (!clock)
+    {
+        throw std::invalid_argument("Clock cannot be null");
+    }
 }
 
-void OrderBook::addOrder(OrderPtr order)
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::addOrder(OrderPtr order)
 {
+    // Anything due must leave before it can match
+    expireOrders();
+
     validateOrder(order);
 
     // Check if order already exists
-    if (m_orders.find(order->getOrderId()) != m_orders.end())
+    if (m_orders.find(order->getOrderId()) != m_orders.end() || m_dayOrderIds.find(order->getOrderId()))
     {
         throw std::invalid_argument("Order with ID " + order->getOrderId() + "already exists");
     }
 
     // Add to tracking
-    m_orders[order->getOrderId()] = order;
+    if (order->getTimeInForce() == TimeInForce::DAY)
+    {
+        m_dayOrders.push_back(order);
+        m_dayOrderIds.insert(order.get());
+    }
+    else
+    {
+        m_orders[order->getOrderId()] = order;
+    }
 
     // Try to match the order
     matchOrder(order);
@@ -33,9 +71,13 @@ void OrderBook::addOrder(OrderPtr order)
     {
         addToAppropriateLevel(order);
     }
+    scheduleExpiry(order);
+
+    publishDepth();
 }
 
-void OrderBook::matchOrder(OrderPtr order)
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::matchOrder(OrderPtr order)
 {
     if (order->getSide() == Side::BUY)
     {
@@ -47,7 +89,8 @@ void OrderBook::matchOrder(OrderPtr order)
     }
 }
 
-void OrderBook::matchBuyOrder(OrderPtr buyOrder)
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::matchBuyOrder(OrderPtr buyOrder)
 {
     // Match against ask levels ( sell orders )
     // We want to match with the lowest ask prices first
@@ -66,16 +109,14 @@ void OrderBook::matchBuyOrder(OrderPtr buyOrder)
         }
 
         // Match as much as possible at this price level
-        std::vector<OrderPtr> filledOrders;
-        Quantity quantityMatched = askLevel->match(
+        std::vector<Fill> fills;
+        Quantity quantityMatched = AllocationPolicy::match(
+            *askLevel,
             buyOrder->getRemainingQuantity(),
-            filledOrders);
+            fills);
 
-        for (auto sellOrder : filledOrders)
-        {
-            Quantity tradeQuantity = std::min(quantityMatched, sellOrder->getQuantity());
-            recordTrade(buyOrder, sellOrder, askPrice, tradeQuantity);
-        }
+        settleFills(fills, *buyOrder, askPrice);
+        markDepthChanged(Side::SELL, askPrice);
 
         // Fill the buy order
         buyOrder->fill(quantityMatched);
@@ -92,7 +133,8 @@ void OrderBook::matchBuyOrder(OrderPtr buyOrder)
     }
 }
 
-void OrderBook::matchSellOrder(OrderPtr sellOrder)
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::matchSellOrder(OrderPtr sellOrder)
 {
     // Match agains bid levels ( buy orders )
     // We want to match with the HIGHEST bid prices first
@@ -111,16 +153,14 @@ void OrderBook::matchSellOrder(OrderPtr sellOrder)
         }
 
         // Match as much as possible at this price level
-        std::vector<OrderPtr> filledOrders;
-        Quantity quantityMatched = bidLevel->match(
+        std::vector<Fill> fills;
+        Quantity quantityMatched = AllocationPolicy::match(
+            *bidLevel,
             sellOrder->getRemainingQuantity(),
-            filledOrders);
+            fills);
 
-        for (auto buyOrder : filledOrders)
-        {
-            Quantity tradeQuantity = std::min(quantityMatched, buyOrder->getQuantity());
-            recordTrade(buyOrder, sellOrder, bidPrice, tradeQuantity);
-        }
+        settleFills(fills, *sellOrder, bidPrice);
+        markDepthChanged(Side::BUY, bidPrice);
 
         // Fill the sell order
         sellOrder->fill(quantityMatched);
@@ -140,17 +180,19 @@ void OrderBook::matchSellOrder(OrderPtr sellOrder)
     }
 }
 
-void OrderBook::addToAppropriateLevel(OrderPtr order)
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::addToAppropriateLevel(OrderPtr order)
 {
     Price price = order->getPrice();
     Side side = order->getSide();
+    markDepthChanged(side, price);
 
     if (side == Side::BUY)
     {
         // Add to bid levels
         if (m_bidLevels.find(price) == m_bidLevels.end())
         {
-            m_bidLevels[price] = std::make_shared<PriceLevel>(price);
+            m_bidLevels[price] = std::make_shared<PriceLevel>(price, *m_orderStore);
         }
         m_bidLevels[price]->addOrder(order);
     }
@@ -159,42 +201,296 @@ void OrderBook::addToAppropriateLevel(OrderPtr order)
         // Add to ask levels
         if (m_askLevels.find(price) == m_askLevels.end())
         {
-            m_askLevels[price] = std::make_shared<PriceLevel>(price);
+            m_askLevels[price] = std::make_shared<PriceLevel>(price, *m_orderStore);
         }
         m_askLevels[price]->addOrder(order);
     }
 }
 
-bool OrderBook::cancelOrder(const OrderId &orderId)
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::removeFromLevel(const Order &order)
 {
+    cancelExpiry(order);
+
+    auto &levels = (order.getSide() == Side::BUY) ? m_bidLevels : m_askLevels;
+    auto levelIt = levels.find(order.getPrice());
+    if (levelIt == levels.end())
+    {
+        return;
+    }
+
+    markDepthChanged(order.getSide(), order.getPrice());
+    levelIt->second->removeOrder(order);
+    if (levelIt->second->isEmpty())
+    {
+        levels.erase(levelIt);
+    }
+}
+
+template <typename AllocationPolicy>
+bool BasicOrderBook<AllocationPolicy>::cancelOrder(const OrderId &orderId)
+{
+    expireOrders();
+
     auto it = m_orders.find(orderId);
-    if (it == m_orders.end())
+    Order *order = (it != m_orders.end()) ? it->second.get() : m_dayOrderIds.find(orderId);
+    if (!order)
     {
         return false;
     }
-    OrderPtr order = it->second;
 
-    // todo: remove from price level ( we'd need to modify PriceLevel )
+    // Still resting: unlink from its price level
+    if (!order->isFilled())
+    {
+        removeFromLevel(*order);
+        recordExecution(*order, ExecType::CANCELLED, m_operationTime);
+    }
 
     order->fill(order->getRemainingQuantity());
 
-    // remove from tracking
-    m_orders.erase(it);
+    // remove from tracking ( a DAY order stays owned by m_dayOrders until end of day )
+    if (it != m_orders.end())
+    {
+        m_orders.erase(it);
+    }
+    else
+    {
+        m_dayOrderIds.erase(orderId);
+    }
 
+    publishDepth();
     return true;
 }
 
-void OrderBook::recordTrade(OrderPtr buyOrder, OrderPtr sellOrder, Price price, Quantity quantity)
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::scheduleExpiry(const OrderPtr &order)
+{
+    switch (order->getTimeInForce())
+    {
+    case TimeInForce::DAY:
+        break; // Tracked in m_dayOrders, which end of day clears
+    case TimeInForce::GTT:
+    case TimeInForce::GTD:
+        if (order->isResting())
+        {
+            m_expiryWheel.schedule(order->getHandle(), order->getExpireTime());
+        }
+        break;
+    default:
+        break; // GTC rests until filled or cancelled
+    }
+}
+
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::cancelExpiry(const Order &order)
+{
+    // The timer is keyed by the order's handle, so it goes before the handle
+    // returns to the store for reuse
+    if (order.getTimeInForce() == TimeInForce::GTT || order.getTimeInForce() == TimeInForce::GTD)
+    {
+        m_expiryWheel.cancel(order.getHandle());
+    }
+}
+
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::setEndOfDay(Timestamp endOfDay)
+{
+    // DAY orders are checked against the deadline only when the book runs an
+    // expiry check, so orders the old deadline has already passed must leave
+    // before a later one replaces it
+    expireOrders();
+    m_endOfDay = endOfDay;
+}
+
+template <typename AllocationPolicy>
+size_t BasicOrderBook<AllocationPolicy>::expireOrders()
+{
+    // Sampled once per operation; everything after this in the same call reuses it
+    m_operationTime = m_clock->now();
+    Timestamp now = m_operationTime;
+    size_t expiredCount = 0;
+
+    if (!m_dayOrders.empty() && now >= m_endOfDay)
+    {
+        expiredCount += expireDayOrders(now);
+    }
+
+    std::vector<OrderHandle> dueHandles;
+    m_expiryWheel.advance(now, dueHandles);
+    if (dueHandles.empty())
+    {
+        if (expiredCount > 0)
+        {
+            publishDepth();
+        }
+        return expiredCount;
+    }
+
+    m_executionReports.reserve(m_executionReports.size() + dueHandles.size());
+
+    // Timers leave the wheel with their orders, so every due handle is a
+    // resting order
+    for (OrderHandle handle : dueHandles)
+    {
+        Order *order = m_orderStore->cold(handle);
+        removeFromLevel(*order);
+        recordExecution(*order, ExecType::EXPIRED, now);
+        order->fill(order->getRemainingQuantity());
+        m_orders.erase(order->getOrderId()); // Last: may free the order
+        expiredCount++;
+    }
+
+    if (expiredCount > 0)
+    {
+        publishDepth();
+    }
+    return expiredCount;
+}
+
+template <typename AllocationPolicy>
+size_t BasicOrderBook<AllocationPolicy>::expireDayOrders(Timestamp now)
+{
+    // Only the DAY orders are visited, in arrival order: resting ones are
+    // unlinked through their handles. A DAY order's life ends with the day,
+    // traded or not, so the ID index is then dropped whole. Erasing each ID
+    // from a hash map cost more than twice the unlinking.
+    m_executionReports.reserve(m_executionReports.size() + m_dayOrders.size());
+
+    size_t expiredCount = 0;
+    for (const auto &order : m_dayOrders)
+    {
+        if (order->isResting())
+        {
+            removeFromLevel(*order);
+            recordExecution(*order, ExecType::EXPIRED, now);
+            order->fill(order->getRemainingQuantity());
+            expiredCount++;
+        }
+    }
+
+    m_dayOrderIds.clear();
+    m_dayOrders.clear();
+
+    return expiredCount;
+}
+
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::recordExecution(const Order &order, ExecType type, Timestamp timestamp)
+{
+    m_executionReports.push_back(ExecutionReport{
+        order.getOrderId(),
+        type,
+        order.getSide(),
+        order.getPrice(),
+        order.getRemainingQuantity(),
+        timestamp});
+}
+
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::setPublisher(std::shared_ptr<BookPublisher> publisher)
+{
+    if (!publisher)
+    {
+        throw std::invalid_argument("Publisher cannot be null");
+    }
+    m_publisherSlot = publisher->registerSymbol(m_symbol);
+    m_publisher = publisher;
+    m_depthChanged = true;
+    publishDepth();
+}
+
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::markDepthChanged(Side side, Price price)
+{
+    // Levels worse than the last published one cannot change the snapshot
+    bool isPublished = (side == Side::BUY) ? price >= m_publishedBidFloor : price <= m_publishedAskCeiling;
+    m_depthChanged = m_depthChanged || isPublished;
+}
+
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::publishDepth()
+{
+    if (!m_publisher || !m_depthChanged)
+    {
+        return;
+    }
+
+    BookSnapshot snapshot;
+    snapshot.timestampNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  m_operationTime.time_since_epoch())
+                                  .count();
+
+    // Best levels first on both sides
+    snapshot.bidDepth = 0;
+    for (auto bidIt = m_bidLevels.rbegin(); bidIt != m_bidLevels.rend() && snapshot.bidDepth < SHARED_BOOK_DEPTH; ++bidIt)
+    {
+        snapshot.bids[snapshot.bidDepth++] = DepthLevel{
+            bidIt->first, bidIt->second->getTotalQuantity(), static_cast<uint32_t>(bidIt->second->getOrderCount())};
+    }
+
+    snapshot.askDepth = 0;
+    for (auto askIt = m_askLevels.begin(); askIt != m_askLevels.end() && snapshot.askDepth < SHARED_BOOK_DEPTH; ++askIt)
+    {
+        snapshot.asks[snapshot.askDepth++] = DepthLevel{
+            askIt->first, askIt->second->getTotalQuantity(), static_cast<uint32_t>(askIt->second->getOrderCount())};
+    }
+
+    // Unused levels are zeroed so readers never see stale prices
+    std::fill(snapshot.bids + snapshot.bidDepth, snapshot.bids + SHARED_BOOK_DEPTH, DepthLevel{});
+    std::fill(snapshot.asks + snapshot.askDepth, snapshot.asks + SHARED_BOOK_DEPTH, DepthLevel{});
+
+    m_publisher->publish(m_publisherSlot, snapshot);
+
+    m_publishedBidFloor = (snapshot.bidDepth == SHARED_BOOK_DEPTH) ? snapshot.bids[SHARED_BOOK_DEPTH - 1].price : 0.0;
+    m_publishedAskCeiling = (snapshot.askDepth == SHARED_BOOK_DEPTH) ? snapshot.asks[SHARED_BOOK_DEPTH - 1].price
+                                                                     : std::numeric_limits<Price>::max();
+    m_depthChanged = false;
+}
+
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::settleFills(const std::vector<Fill> &fills, const Order &incomingOrder, Price price)
+{
+    // Matching only touched hot records; this is the first time the resting
+    // orders themselves are read. Filled ones leave the store in a short loop
+    // of its own, so their cache misses overlap instead of queueing behind
+    // trade allocation. Release only writes the order's terms back, so its ID,
+    // which may sit on another line, is prefetched for the trade pass. They
+    // stay alive through the book's order tracking.
+    thread_local std::vector<const Order *> restingOrders;
+    restingOrders.clear();
+    for (const auto &fill : fills)
+    {
+        const Order *restingOrder = m_orderStore->cold(fill.handle);
+        prefetch(&restingOrder->getOrderId());
+        restingOrders.push_back(restingOrder);
+        if (m_orderStore->hot(fill.handle).remainingQuantity == 0)
+        {
+            cancelExpiry(*restingOrder);
+            m_orderStore->release(fill.handle);
+        }
+    }
+
+    bool isBuy = incomingOrder.getSide() == Side::BUY;
+    for (size_t i = 0; i < fills.size(); ++i)
+    {
+        const Order &restingOrder = *restingOrders[i];
+        recordTrade(isBuy ? incomingOrder : restingOrder, isBuy ? restingOrder : incomingOrder, price, fills[i].quantity);
+    }
+}
+
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::recordTrade(const Order &buyOrder, const Order &sellOrder, Price price, Quantity quantity)
 {
     auto trade = std::make_shared<Trade>(
-        buyOrder->getOrderId(),
-        sellOrder->getOrderId(),
+        buyOrder.getOrderId(),
+        sellOrder.getOrderId(),
         price,
         quantity);
     m_trades.push_back(trade);
 }
 
-Price OrderBook::getBestBidPrice() const
+template <typename AllocationPolicy>
+Price BasicOrderBook<AllocationPolicy>::getBestBidPrice() const
 {
     if (m_bidLevels.empty())
     {
@@ -203,7 +499,8 @@ Price OrderBook::getBestBidPrice() const
     return m_bidLevels.rbegin()->first;
 }
 
-Price OrderBook::getBestAskPrice() const
+template <typename AllocationPolicy>
+Price BasicOrderBook<AllocationPolicy>::getBestAskPrice() const
 {
     if (m_askLevels.empty())
     {
@@ -212,7 +509,8 @@ Price OrderBook::getBestAskPrice() const
     return m_askLevels.begin()->first;
 }
 
-Price OrderBook::getSpread() const
+template <typename AllocationPolicy>
+Price BasicOrderBook<AllocationPolicy>::getSpread() const
 {
     Price bestBid = getBestBidPrice();
     Price bestAsk = getBestAskPrice();
@@ -225,7 +523,8 @@ Price OrderBook::getSpread() const
     return bestAsk - bestBid;
 }
 
-void OrderBook::validateOrder(OrderPtr order) const
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::validateOrder(OrderPtr order) const
 {
     if (!order)
     {
@@ -236,9 +535,38 @@ void OrderBook::validateOrder(OrderPtr order) const
     {
         throw std::invalid_argument("Cannot add already filled order");
     }
+
+    if (order->isResting())
+    {
+        throw std::invalid_argument("Order is already resting in a book");
+    }
+
+    switch (order->getTimeInForce())
+    {
+    case TimeInForce::DAY:
+        if (m_endOfDay == Timestamp())
+        {
+            throw std::invalid_argument("DAY orders need the book's end of day to be set");
+        }
+        if (m_endOfDay <= m_operationTime)
+        {
+            throw std::invalid_argument("DAY order received after end of day");
+        }
+        break;
+    case TimeInForce::GTT:
+    case TimeInForce::GTD:
+        if (order->getExpireTime() <= m_operationTime)
+        {
+            throw std::invalid_argument("Order has already expired");
+        }
+        break;
+    default:
+        break;
+    }
 }
 
-void OrderBook::printOrderBook(int levels) const
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::printOrderBook(int levels) const
 {
     std::cout << "\n=== ORDER BOOK FOR " << m_symbol << " ===" << std::endl;
     std::cout << std::fixed << std::setprecision(2);
@@ -278,6 +606,39 @@ void OrderBook::printOrderBook(int levels) const
         ++bidCount;
     }
 
-    std::cout << "\nTotal Orders: " << m_orders.size() << std::endl;
+    std::cout << "\nTotal Orders: " << getTotalOrders() << std::endl;
     std::cout << "Total Trades: " << m_trades.size() << std::endl;
-}
\ No newline at end of file
+}
+
+template <typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::logOrderBook(BinaryLogger &logger, int levels) const
+{
+    static const BinaryLogger::FormatId header = BinaryLogger::registerFormat("=== ORDER BOOK FOR {} ===");
+    static const BinaryLogger::FormatId askLevel = BinaryLogger::registerFormat("ASK ${%7.2f} | {%8d} | {}");
+    static const BinaryLogger::FormatId spread = BinaryLogger::registerFormat("--- SPREAD: ${%.2f} ---");
+    static const BinaryLogger::FormatId bidLevel = BinaryLogger::registerFormat("BID ${%7.2f} | {%8d} | {}");
+    static const BinaryLogger::FormatId totals = BinaryLogger::registerFormat("Total Orders: {}, Total Trades: {}");
+
+    logger.log(header, m_symbol);
+
+    // Same order as printOrderBook: asks highest to lowest, then bids
+    auto askIt = m_askLevels.rbegin();
+    for (int askCount = 0; askIt != m_askLevels.rend() && askCount < levels; ++askIt, ++askCount)
+    {
+        logger.log(askLevel, askIt->first, askIt->second->getTotalQuantity(), askIt->second->getOrderCount());
+    }
+
+    logger.log(spread, getSpread());
+
+    auto bidIt = m_bidLevels.rbegin();
+    for (int bidCount = 0; bidIt != m_bidLevels.rend() && bidCount < levels; ++bidIt, ++bidCount)
+    {
+        logger.log(bidLevel, bidIt->first, bidIt->second->getTotalQuantity(), bidIt->second->getOrderCount());
+    }
+
+    logger.log(totals, getTotalOrders(), m_trades.size());
+}
+
+template class BasicOrderBook<FifoAllocation>;
+template class BasicOrderBook<ProRataAllocation>;
+template class BasicOrderBook<HybridAllocation>;
@@ -0,0 +1,110 @@
+#include "OrderIndex.h"
+#include <functional>
+
+namespace
+{
+    const size_t MIN_SLOTS = 64;
+    const size_t NOT_FOUND = static_cast<size_t>(-1);
+}
+
+OrderIndex::OrderIndex()
+    : m_size(0)
+{
+}
+
+size_t OrderIndex::hashOf(const OrderId &orderId)
+{
+    return std::hash<OrderId>()(orderId);
+}
+
+size_t OrderIndex::findSlot(const OrderId &orderId) const
+{
+    if (m_slots.empty())
+    {
+        return NOT_FOUND;
+    }
+
+    size_t hash = hashOf(orderId);
+    size_t mask = m_slots.size() - 1;
+    for (size_t i = hash & mask; m_slots[i].order; i = (i + 1) & mask)
+    {
+        if (m_slots[i].hash == hash && m_slots[i].order->getOrderId() == orderId)
+        {
+            return i;
+        }
+    }
+    return NOT_FOUND;
+}
+
+Order *OrderIndex::find(const OrderId &orderId) const
+{
+    size_t slot = findSlot(orderId);
+    return slot == NOT_FOUND ? nullptr : m_slots[slot].order;
+}
+
+void OrderIndex::insert(Order *order)
+{
+    if ((m_size + 1) * 2 > m_slots.size())
+    {
+        grow();
+    }
+    place(Slot{order, hashOf(order->getOrderId())});
+    m_size++;
+}
+
+bool OrderIndex::erase(const OrderId &orderId)
+{
+    size_t gap = findSlot(orderId);
+    if (gap == NOT_FOUND)
+    {
+        return false;
+    }
+
+    // Backward shift instead of tombstones: pull later entries of the probe
+    // run into the gap whenever the gap lies between their home slot and
+    // where they sit, so no lookup stops short at an empty slot
+    size_t mask = m_slots.size() - 1;
+    for (size_t i = (gap + 1) & mask; m_slots[i].order; i = (i + 1) & mask)
+    {
+        size_t home = m_slots[i].hash & mask;
+        if (((i - home) & mask) >= ((i - gap) & mask))
+        {
+            m_slots[gap] = m_slots[i];
+            gap = i;
+        }
+    }
+    m_slots[gap] = Slot{nullptr, 0};
+    m_size--;
+    return true;
+}
+
+void OrderIndex::clear()
+{
+    // Dropped whole; the next insert starts a fresh array
+    std::vector<Slot>().swap(m_slots);
+    m_size = 0;
+}
+
+void OrderIndex::place(Slot slot)
+{
+    size_t mask = m_slots.size() - 1;
+    size_t i = slot.hash & mask;
+    while (m_slots[i].order)
+    {
+        i = (i + 1) & mask;
+    }
+    m_slots[i] = slot;
+}
+
+void OrderIndex::grow()
+{
+    std::vector<Slot> old(m_slots.empty() ? MIN_SLOTS : m_slots.size() * 2, Slot{nullptr, 0});
+    old.swap(m_slots);
+    for (const auto &slot : old)
+    {
+        if (slot.order)
+        {
+            place(slot);
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#include "OrderStore.h"
+#include <stdexcept>
+
+OrderStore::OrderStore()
+    : m_freeHead(INVALID_HANDLE), m_size(0)
+{
+}
+
+OrderStore::~OrderStore()
+{
+    // Orders still resting outlive the book that held them
+    for (size_t handle = 0; handle < m_cold.size(); ++handle)
+    {
+        if (m_cold[handle])
+        {
+            m_cold[handle]->detach(m_hot[handle]);
+        }
+    }
+}
+
+OrderHandle OrderStore::allocate(Order *order)
+{
+    if (order->isResting())
+    {
+        throw std::invalid_argument("Order is already resting");
+    }
+
+    OrderHandle handle;
+    if (m_freeHead != INVALID_HANDLE)
+    {
+        handle = m_freeHead;
+        m_freeHead = m_hot[handle].next;
+        m_cold[handle] = order;
+    }
+    else
+    {
+        if (m_hot.size() >= INVALID_HANDLE)
+        {
+            throw std::length_error("Order store is full");
+        }
+        handle = static_cast<OrderHandle>(m_hot.size());
+        m_hot.emplace_back();
+        m_cold.push_back(order);
+    }
+
+    OrderRecord &record = m_hot[handle];
+    record.price = order->getPrice();
+    record.remainingQuantity = order->getRemainingQuantity();
+    record.side = order->getSide();
+    record.prev = INVALID_HANDLE;
+    record.next = INVALID_HANDLE;
+    order->attach(this, handle);
+
+    m_size++;
+    return handle;
+}
+
+void OrderStore::release(OrderHandle handle)
+{
+    m_cold[handle]->detach(m_hot[handle]);
+    m_cold[handle] = nullptr;
+
+    m_hot[handle].next = m_freeHead;
+    m_freeHead = handle;
+    m_size--;
+}
+
+void OrderStore::reserve(size_t capacity)
+{
+    m_hot.reserve(capacity);
+    m_cold.reserve(capacity);
+}
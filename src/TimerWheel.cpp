@@ -0,0 +1,268 @@
+#include "TimerWheel.h"
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+    constexpr uint64_t SLOT_MASK = TimerWheel::SLOTS - 1;
+
+    int lowestSetBit(uint64_t bits)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(bits);
+#endif
+    }
+
+    uint64_t levelSpan(int level)
+    {
+        return uint64_t(1) << (TimerWheel::SLOT_BITS * level);
+    }
+}
+
+TimerWheel::TimerWheel(Timestamp start)
+    : m_occupied{}, m_currentTick(toTick(start)), m_size(0)
+{
+    m_lists.fill(List{INVALID_HANDLE, INVALID_HANDLE});
+}
+
+uint64_t TimerWheel::toTick(Timestamp time)
+{
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+    return ms > 0 ? static_cast<uint64_t>(ms) : 0;
+}
+
+void TimerWheel::schedule(OrderHandle handle, Timestamp expireTime)
+{
+    if (handle >= m_timers.size())
+    {
+        m_timers.resize(handle + 1, Timer{0, INVALID_HANDLE, INVALID_HANDLE, NO_LIST});
+    }
+    cancel(handle);
+
+    // advance() treats a tick as due once 'now' reaches its start, so round up:
+    // a timer in the middle of a tick must wait for the next one
+    uint64_t expireTick = toTick(expireTime);
+    if (expireTime > Timestamp(std::chrono::milliseconds(expireTick)))
+    {
+        expireTick++;
+    }
+    m_timers[handle].expireTick = expireTick;
+    m_size++;
+
+    // Due in a tick the wheel has already passed: hand it out on the next advance
+    if (expireTick < m_currentTick)
+    {
+        link(handle, OVERDUE_LIST);
+        return;
+    }
+
+    insert(handle);
+}
+
+void TimerWheel::cancel(OrderHandle handle)
+{
+    if (handle < m_timers.size() && m_timers[handle].list != NO_LIST)
+    {
+        unlink(handle);
+        m_size--;
+    }
+}
+
+void TimerWheel::link(OrderHandle handle, uint16_t list)
+{
+    Timer &timer = m_timers[handle];
+    List &target = m_lists[list];
+
+    timer.list = list;
+    timer.prev = target.tail;
+    timer.next = INVALID_HANDLE;
+    if (target.tail != INVALID_HANDLE)
+    {
+        m_timers[target.tail].next = handle;
+    }
+    else
+    {
+        target.head = handle;
+    }
+    target.tail = handle;
+
+    if (list < OVERDUE_LIST)
+    {
+        m_occupied[list / SLOTS] |= uint64_t(1) << (list % SLOTS);
+    }
+}
+
+void TimerWheel::unlink(OrderHandle handle)
+{
+    Timer &timer = m_timers[handle];
+    List &source = m_lists[timer.list];
+
+    if (timer.prev != INVALID_HANDLE)
+    {
+        m_timers[timer.prev].next = timer.next;
+    }
+    else
+    {
+        source.head = timer.next;
+    }
+    if (timer.next != INVALID_HANDLE)
+    {
+        m_timers[timer.next].prev = timer.prev;
+    }
+    else
+    {
+        source.tail = timer.prev;
+    }
+
+    if (source.head == INVALID_HANDLE && timer.list < OVERDUE_LIST)
+    {
+        m_occupied[timer.list / SLOTS] &= ~(uint64_t(1) << (timer.list % SLOTS));
+    }
+    timer.list = NO_LIST;
+}
+
+OrderHandle TimerWheel::takeList(uint16_t list)
+{
+    // The detached timers keep their links; callers walk them and relink or
+    // drop each one
+    OrderHandle head = m_lists[list].head;
+    m_lists[list] = List{INVALID_HANDLE, INVALID_HANDLE};
+    if (list < OVERDUE_LIST)
+    {
+        m_occupied[list / SLOTS] &= ~(uint64_t(1) << (list % SLOTS));
+    }
+    return head;
+}
+
+void TimerWheel::insert(OrderHandle handle)
+{
+    uint64_t tick = m_timers[handle].expireTick;
+    uint64_t delta = tick - m_currentTick;
+
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= levelSpan(level + 1))
+    {
+        level++;
+    }
+
+    // Beyond the top level's range: park at its far end, re-checked on the way down
+    if (delta >= levelSpan(LEVELS))
+    {
+        tick = m_currentTick + levelSpan(LEVELS) - 1;
+    }
+
+    size_t slot = (tick >> (SLOT_BITS * level)) & SLOT_MASK;
+    link(handle, static_cast<uint16_t>(level * SLOTS + slot));
+}
+
+void TimerWheel::cascade(int level)
+{
+    size_t slot = (m_currentTick >> (SLOT_BITS * level)) & SLOT_MASK;
+    if (!(m_occupied[level] & (uint64_t(1) << slot)))
+    {
+        return;
+    }
+
+    OrderHandle handle = takeList(static_cast<uint16_t>(level * SLOTS + slot));
+    while (handle != INVALID_HANDLE)
+    {
+        OrderHandle next = m_timers[handle].next;
+        insert(handle);
+        handle = next;
+    }
+}
+
+void TimerWheel::expireSlot(std::vector<OrderHandle> &expired)
+{
+    size_t slot = m_currentTick & SLOT_MASK;
+    if (!(m_occupied[0] & (uint64_t(1) << slot)))
+    {
+        return;
+    }
+
+    OrderHandle handle = takeList(static_cast<uint16_t>(slot));
+    while (handle != INVALID_HANDLE)
+    {
+        OrderHandle next = m_timers[handle].next;
+        if (m_timers[handle].expireTick > m_currentTick)
+        {
+            insert(handle); // Was parked past the wheel's range
+        }
+        else
+        {
+            m_timers[handle].list = NO_LIST;
+            m_size--;
+            expired.push_back(handle);
+        }
+        handle = next;
+    }
+}
+
+void TimerWheel::advance(Timestamp now, std::vector<OrderHandle> &expired)
+{
+    uint64_t targetTick = toTick(now);
+
+    for (OrderHandle handle = takeList(OVERDUE_LIST); handle != INVALID_HANDLE; handle = m_timers[handle].next)
+    {
+        m_timers[handle].list = NO_LIST;
+        m_size--;
+        expired.push_back(handle);
+    }
+
+    while (m_currentTick <= targetTick)
+    {
+        if (m_size == 0)
+        {
+            m_currentTick = targetTick + 1;
+            break;
+        }
+
+        // On a level-0 wrap, pull timers down from every level that wrapped too,
+        // highest first so entries can fall through more than one level
+        if ((m_currentTick & SLOT_MASK) == 0)
+        {
+            int top = 1;
+            while (top < LEVELS - 1 && ((m_currentTick >> (SLOT_BITS * top)) & SLOT_MASK) == 0)
+            {
+                top++;
+            }
+            for (int level = top; level >= 1; level--)
+            {
+                cascade(level);
+            }
+        }
+
+        expireSlot(expired);
+
+        // Jump to the next tick where something can happen. Within a level only
+        // slots after the current one are due this rotation; any other bit means
+        // work at the next wrap. An empty level defers to the one above it.
+        uint64_t nextTick = 0;
+        for (int level = 0; level < LEVELS; level++)
+        {
+            int shift = SLOT_BITS * level;
+            uint64_t slot = (m_currentTick >> shift) & SLOT_MASK;
+            uint64_t rotationStart = (m_currentTick >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+            uint64_t later = slot == SLOT_MASK ? 0 : m_occupied[level] & (~uint64_t(0) << (slot + 1));
+
+            if (later)
+            {
+                nextTick = rotationStart + (uint64_t(lowestSetBit(later)) << shift);
+                break;
+            }
+            if (m_occupied[level] || level == LEVELS - 1)
+            {
+                nextTick = rotationStart + levelSpan(level + 1);
+                break;
+            }
+        }
+
+        m_currentTick = std::min(nextTick, targetTick + 1);
+    }
+}
@@ -1,6 +1,11 @@
 #include "OrderBook.h"
 #include "Order.h"
 #include "Types.h"
+#include "Clock.h"
+#include "BookPublisher.h"
+#include "BookReader.h"
+#include "BinaryLogger.h"
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -157,6 +162,142 @@ void demonstrateEdgeCases()
     }
 }
 
+void demonstrateOrderExpiry()
+{
+    printSeparator("ORDER EXPIRY DEMONSTRATION");
+
+    // Drive the book from a manual clock so expiry is deterministic
+    auto clock = std::make_shared<ManualClock>();
+    OrderBook orderBook("NVDA", clock);
+    orderBook.setEndOfDay(clock->now() + std::chrono::hours(8));
+
+    orderBook.addOrder(std::make_shared<Order>("GTC_001", Side::BUY, 120.00, 500));
+    orderBook.addOrder(std::make_shared<Order>("DAY_001", Side::BUY, 119.50, 300, TimeInForce::DAY));
+    orderBook.addOrder(std::make_shared<Order>("GTT_001", Side::SELL, 121.00, 400, TimeInForce::GTT,
+                                               clock->now() + std::chrono::minutes(30)));
+
+    std::cout << "Orders resting: " << orderBook.getTotalOrders()
+              << ", pending expiries: " << orderBook.getPendingExpiries() << std::endl;
+
+    std::cout << "\n>>> 31 minutes later" << std::endl;
+    clock->advance(std::chrono::minutes(31));
+    std::cout << "Expired: " << orderBook.expireOrders() << " (best ask now $" << orderBook.getBestAskPrice() << ")" << std::endl;
+
+    std::cout << "\n>>> End of day" << std::endl;
+    clock->advance(std::chrono::hours(8));
+    std::cout << "Expired: " << orderBook.expireOrders() << std::endl;
+    orderBook.printOrderBook(3);
+
+    std::cout << "\n--- EXECUTION REPORTS ---" << std::endl;
+    for (const auto &report : orderBook.getExecutionReports())
+    {
+        std::cout << (report.type == ExecType::EXPIRED ? "EXPIRED " : "CANCELLED ")
+                  << report.orderId << " " << sideToString(report.side)
+                  << " " << report.leavesQuantity << " @ $" << report.price << std::endl;
+    }
+}
+
+template <typename Book>
+void runAllocationExample(const std::string &title)
+{
+    Book orderBook("ES");
+    orderBook.addOrder(std::make_shared<Order>("SELL_A", Side::SELL, 5000.00, 100));
+    orderBook.addOrder(std::make_shared<Order>("SELL_B", Side::SELL, 5000.00, 300));
+    orderBook.addOrder(std::make_shared<Order>("SELL_C", Side::SELL, 5000.00, 600));
+    orderBook.addOrder(std::make_shared<Order>("BUY_001", Side::BUY, 5000.00, 500));
+
+    std::cout << "\n" << title << ":" << std::endl;
+    for (const auto &trade : orderBook.getTrades())
+    {
+        std::cout << "  " << trade->sellOrderId << " filled " << trade->quantity << std::endl;
+    }
+}
+
+void demonstrateAllocationPolicies()
+{
+    printSeparator("ALLOCATION POLICY DEMONSTRATION");
+
+    std::cout << "Resting at $5000.00: SELL_A 100, SELL_B 300, SELL_C 600 (in time order)" << std::endl;
+    std::cout << "Incoming BUY 500 at $5000.00" << std::endl;
+
+    runAllocationExample<OrderBook>("FIFO");
+    runAllocationExample<ProRataOrderBook>("Pro-rata");
+    runAllocationExample<HybridOrderBook>("Hybrid (top order FIFO, rest pro-rata)");
+}
+
+void demonstrateSharedPublication()
+{
+    printSeparator("SHARED MEMORY PUBLICATION DEMONSTRATION");
+
+    try
+    {
+        // Engine side: publish every change to AMZN into shared memory
+        auto publisher = std::make_shared<BookPublisher>("/orderbook_demo");
+        OrderBook orderBook("AMZN");
+        orderBook.setPublisher(publisher);
+
+        orderBook.addOrder(std::make_shared<Order>("BUY_001", Side::BUY, 180.00, 200));
+        orderBook.addOrder(std::make_shared<Order>("BUY_002", Side::BUY, 179.50, 300));
+        orderBook.addOrder(std::make_shared<Order>("SELL_001", Side::SELL, 180.50, 150));
+
+        // Reader side: normally another process attaching by name
+        BookReader reader("/orderbook_demo");
+        uint32_t slot;
+        if (!reader.findSymbol("AMZN", slot))
+        {
+            std::cout << "AMZN not found in shared memory" << std::endl;
+            return;
+        }
+
+        BookSnapshot snapshot;
+        reader.read(slot, snapshot);
+        std::cout << "Snapshot #" << snapshot.updateId << " for " << snapshot.symbol << std::endl;
+        for (uint32_t i = 0; i < snapshot.bidDepth; ++i)
+        {
+            std::cout << "  BID $" << snapshot.bids[i].price << " x " << snapshot.bids[i].quantity << std::endl;
+        }
+        for (uint32_t i = 0; i < snapshot.askDepth; ++i)
+        {
+            std::cout << "  ASK $" << snapshot.asks[i].price << " x " << snapshot.asks[i].quantity << std::endl;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cout << "Shared memory unavailable: " << e.what() << std::endl;
+    }
+}
+
+void demonstrateBinaryLogging()
+{
+    printSeparator("BINARY LOGGING DEMONSTRATION");
+
+    // The engine thread only copies arguments into its ring; a background
+    // thread formats them and writes the file
+    const std::string logPath = "orderbook.log";
+    {
+        BinaryLogger logger(logPath);
+        OrderBook orderBook("NFLX");
+
+        auto buyOrder = std::make_shared<Order>("BUY_001", Side::BUY, 650.00, 40);
+        auto sellOrder = std::make_shared<Order>("SELL_001", Side::SELL, 651.25, 25);
+        orderBook.addOrder(buyOrder);
+        orderBook.addOrder(sellOrder);
+
+        buyOrder->logTo(logger);
+        sellOrder->logTo(logger);
+        orderBook.logOrderBook(logger);
+        logger.flush();
+    }
+
+    std::cout << "Contents of " << logPath << ":" << std::endl;
+    std::ifstream logFile(logPath);
+    std::string line;
+    while (std::getline(logFile, line))
+    {
+        std::cout << "  " << line << std::endl;
+    }
+}
+
 int main()
 {
     std::cout << "🚀 ADVANCED ORDER BOOK SYSTEM 🚀" << std::endl;
@@ -169,6 +310,10 @@ int main()
         demonstrateOrderBook();
         demonstrateOrderMatching();
         demonstrateEdgeCases();
+        demonstrateOrderExpiry();
+        demonstrateAllocationPolicies();
+        demonstrateSharedPublication();
+        demonstrateBinaryLogging();
 
         printSeparator("DEMONSTRATION COMPLETE");
         std::cout << "✅ All tests completed successfully!" << std::endl;